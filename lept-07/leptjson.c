@@ -1,3 +1,7 @@
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200112L   /* pthreads, mmap() under -ansi */
+#endif
+
 #include "leptjson.h"
 
 #include <assert.h>  /* assert() */
@@ -5,16 +9,63 @@
 #include <string.h>  /* memcpy() */
 
 #include <math.h>    /* HUGE_VAL */
+#include <float.h>   /* DBL_MAX */
 #include <errno.h>   /* errno, ERANGE */
+#include <locale.h>  /* localeconv() */
+
+#include <stdio.h>   /* sprintf(), fopen() */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEPT_SIMD_X86 1
+#include <immintrin.h> /* SSE2, AVX2 */
+/*
+ * SIMD kernels read whole aligned blocks, possibly past the terminator but
+ * never past its page; exempt them from the sanitizers' byte-exact bounds.
+ */
+#define LEPT_SIMD_KERNEL(isa) __attribute__((target(isa), no_sanitize_address, no_sanitize_thread))
+#endif
+
+#if defined(__GNUC__)
+/* word loads that may read past the terminator, never past its page (see above) */
+#define LEPT_WORD_LOAD __attribute__((no_sanitize_address, no_sanitize_thread))
+#else
+#define LEPT_WORD_LOAD
+#endif
+
+#if defined(_POSIX_C_SOURCE) && !defined(LEPT_NO_THREADS)
+#define LEPT_THREADS 1
+#include <pthread.h>   /* lept_parse_ndjson(), kernel resolution */
+#endif
+
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L && !defined(LEPT_NO_MMAP)
+#define LEPT_MMAP 1
+#include <fcntl.h>     /* open() */
+#include <sys/mman.h>  /* mmap(), posix_madvise() */
+#include <sys/stat.h>  /* fstat() */
+#include <unistd.h>    /* close(), sysconf() */
+#endif
+
+#define LEPT_U64(hi, lo) (((lept_uint64)(hi) << 32) | (lept_uint64)(lo))
+#define LEPT_INT64_MAX   LEPT_U64(0x7FFFFFFF, 0xFFFFFFFF)
 
-#include <stdio.h>  /* test */
+/* lept_value.flags */
+#define LEPT_VALUE_UNSIGNED  0x1    /* LEPT_INTEGER above INT64_MAX, read u.i as uint64 */
+#define LEPT_VALUE_RAW       0x2    /* LEPT_NUMBER not converted yet, u.r is its literal */
+#define LEPT_VALUE_BORROWED  0x4    /* u.s.s, u.a.e or u.o.m is not owned by the value */
+#define LEPT_VALUE_BORROWED_KEYS 0x8    /* object keys are not owned by the value */
+
+/* lept_context.flags, beyond the public LEPT_PARSE_FLAG_* */
+#define LEPT_PARSE_INSITU    0x10000    /* strings are decoded in place in json */
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
 #endif
 
 #define EXPECT(c, ch)   do{assert(*c->json == (ch));c->json++;}while(0)
+/* the byte at p, with the end of a length-delimited input reading as '\0' */
+#define PEEK(c, p)      ((p) != (c)->end ? *(p) : '\0')
 
+#define IS_WHITESPACE(ch) ((ch) == ' ' || (ch) == '\t' || (ch) == '\r' || (ch) == '\n')
 #define IS_DIGIT(ch)      ((ch) >= '0' && (ch) <= '9')
 #define IS_DIGIT_1_9(ch)  ((ch) >= '1' && (ch) <= '9')
 #define PUTC(c, ch) do { *(char*)lept_context_push(c, sizeof(char)) = (ch); } while(0)
@@ -22,11 +73,36 @@
 
 typedef struct {
     const char* json;
+    const char* end;        /* end of json, or NULL if it is '\0'-terminated */
     char* stack;
     size_t size, top;
+    int flags;              /* LEPT_PARSE_FLAG_* */
+    size_t max_depth;       /* nesting limit, (size_t)-1 for none */
+    lept_document* doc;     /* nodes come from its arena, or from alloc if NULL */
+    const lept_allocator* alloc;
 }lept_context;
 
-static int lept_parse_value(lept_context* c, lept_value* v);/* forward declaration */
+/* allocator: a NULL lept_allocator* anywhere stands for malloc(), realloc() and free() */
+static void* lept_std_alloc(void* user, size_t size) {
+    (void)user;
+    return malloc(size);
+}
+static void* lept_std_realloc(void* user, void* ptr, size_t size) {
+    (void)user;
+    return realloc(ptr, size);
+}
+static void lept_std_free(void* user, void* ptr) {
+    (void)user;
+    free(ptr);
+}
+
+static const lept_allocator lept_std_allocator = { lept_std_alloc, lept_std_realloc, lept_std_free, NULL };
+
+#define LEPT_ALLOCATOR(a)          ((a) != NULL ? (a) : &lept_std_allocator)
+
+#define LEPT_MALLOC(a, size)       ((a)->alloc((a)->user, (size)))
+#define LEPT_REALLOC(a, ptr, size) ((a)->realloc((a)->user, (ptr), (size)))
+#define LEPT_FREE(a, ptr)          ((a)->free((a)->user, (ptr)))
 
 static void* lept_context_push(lept_context* c, size_t size) {
     void * ret;
@@ -38,7 +114,7 @@ static void* lept_context_push(lept_context* c, size_t size) {
         while(c->top + size >= c->size) {
             c->size += c->size >> 1; /* c->size *= 1.5 */
         }
-        c->stack = (char*) realloc(c->stack, c->size);
+        c->stack = (char*) LEPT_REALLOC(c->alloc, c->stack, c->size);
     }
     ret = c->stack + c->top;
     c->top += size;
@@ -50,438 +126,4973 @@ static void* lept_context_pop(lept_context* c, size_t size) {
     return c->stack + (c->top -= size);
 }
 
-static void lept_parse_whitespace(lept_context* c) {
-   const char *p = c->json;
-   while(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'){
-       p++;
-   }
-   c->json = p;
+/*
+ * document arena: a list of blocks, newest first, carved by bumping `used`.
+ * Each block is at least twice the previous one, so a document takes
+ * O(log n) blocks.
+ */
+#ifndef LEPT_ARENA_BLOCK_SIZE
+#define LEPT_ARENA_BLOCK_SIZE 4096
+#endif
+
+#define LEPT_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+struct lept_chunk {
+    lept_chunk* next;
+    size_t size, used;
+};
+
+#define LEPT_CHUNK_HEADER LEPT_ALIGN(sizeof(lept_chunk))
+
+static const lept_allocator* lept_document_allocator(const lept_document* d) {
+    return LEPT_ALLOCATOR(d->allocator);
+}
+
+static void* lept_arena_alloc(lept_document* d, size_t size) {
+    lept_chunk* chunk = d->chunk;
+    size = LEPT_ALIGN(size);
+    if (chunk == NULL || chunk->used + size > chunk->size) {
+        size_t n = (chunk == NULL) ? LEPT_ARENA_BLOCK_SIZE : chunk->size * 2;
+        while (n < size) {
+            n *= 2;
+        }
+        chunk = (lept_chunk*) LEPT_MALLOC(lept_document_allocator(d), LEPT_CHUNK_HEADER + n);
+        chunk->next = d->chunk;
+        chunk->size = n;
+        chunk->used = 0;
+        d->chunk = chunk;
+    }
+    chunk->used += size;
+    return (char*)chunk + LEPT_CHUNK_HEADER + chunk->used - size;
+}
+
+/* node storage for the tree being parsed */
+static void* lept_context_alloc(lept_context* c, size_t size) {
+    return c->doc ? lept_arena_alloc(c->doc, size) : LEPT_MALLOC(c->alloc, size);
+}
+
+/*
+ * whitespace kernels: return the first byte at or after p that is not
+ * ' ', '\t', '\r' or '\n', or end if there is none before it. With end NULL
+ * the input is '\0'-terminated; the terminator is not whitespace, so every
+ * kernel stops there. The SIMD kernels only issue aligned loads, which never
+ * cross a page boundary and therefore never fault past the terminator or
+ * the page of the last byte before end.
+ */
+typedef const char* (*lept_skip_func)(const char* p, const char* end);
+
+static const char* lept_skip_whitespace_scalar(const char* p, const char* end) {
+    while (p != end && IS_WHITESPACE(*p)) {
+        p++;
+    }
+    return p;
+}
+
+#ifdef LEPT_SIMD_X86
+LEPT_SIMD_KERNEL("sse2")
+static const char* lept_skip_whitespace_sse2(const char* p, const char* end) {
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i ht = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    size_t off = (size_t)p & 15;
+    const char* b = p - off;
+    unsigned int mask;
+    __m128i x, ws;
+
+    if (p == end) {
+        return p;
+    }
+
+    x  = _mm_load_si128((const __m128i*)b);
+    ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, ht)),
+                      _mm_or_si128(_mm_cmpeq_epi8(x, cr), _mm_cmpeq_epi8(x, lf)));
+    mask = ~(unsigned int)_mm_movemask_epi8(ws) & (0xFFFFu << off) & 0xFFFFu;
+    while (mask == 0) {
+        b += 16;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x  = _mm_load_si128((const __m128i*)b);
+        ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, ht)),
+                          _mm_or_si128(_mm_cmpeq_epi8(x, cr), _mm_cmpeq_epi8(x, lf)));
+        mask = ~(unsigned int)_mm_movemask_epi8(ws) & 0xFFFFu;
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+
+LEPT_SIMD_KERNEL("avx2")
+static const char* lept_skip_whitespace_avx2(const char* p, const char* end) {
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i ht = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    size_t off = (size_t)p & 31;
+    const char* b = p - off;
+    unsigned int mask;
+    __m256i x, ws;
+
+    if (p == end) {
+        return p;
+    }
+
+    x  = _mm256_load_si256((const __m256i*)b);
+    ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, ht)),
+                         _mm256_or_si256(_mm256_cmpeq_epi8(x, cr), _mm256_cmpeq_epi8(x, lf)));
+    mask = ~(unsigned int)_mm256_movemask_epi8(ws) & (0xFFFFFFFFu << off);
+    while (mask == 0) {
+        b += 32;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x  = _mm256_load_si256((const __m256i*)b);
+        ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, ht)),
+                             _mm256_or_si256(_mm256_cmpeq_epi8(x, cr), _mm256_cmpeq_epi8(x, lf)));
+        mask = ~(unsigned int)_mm256_movemask_epi8(ws);
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+#endif /* LEPT_SIMD_X86 */
+
+/*
+ * string kernels: return the first byte at or after p that ends a run of
+ * plain string content, i.e. '\"', '\\' or a control character (< 0x20,
+ * which includes the '\0' terminator), or end as for whitespace.
+ */
+static const char* lept_scan_string_scalar(const char* p, const char* end) {
+    while (p != end && *p != '\"' && *p != '\\' && (unsigned char)*p >= 0x20) {
+        p++;
+    }
+    return p;
+}
+
+#ifdef LEPT_SIMD_X86
+LEPT_SIMD_KERNEL("sse2")
+static const char* lept_scan_string_sse2(const char* p, const char* end) {
+    const __m128i qt = _mm_set1_epi8('\"');
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i ct = _mm_set1_epi8(0x1F);
+    size_t off = (size_t)p & 15;
+    const char* b = p - off;
+    unsigned int mask;
+    __m128i x, m;
+
+    if (p == end) {
+        return p;
+    }
+
+    x = _mm_load_si128((const __m128i*)b);
+    m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, qt), _mm_cmpeq_epi8(x, bs)),
+                     _mm_cmpeq_epi8(_mm_min_epu8(x, ct), x));
+    mask = (unsigned int)_mm_movemask_epi8(m) & (0xFFFFu << off);
+    while (mask == 0) {
+        b += 16;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x = _mm_load_si128((const __m128i*)b);
+        m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, qt), _mm_cmpeq_epi8(x, bs)),
+                         _mm_cmpeq_epi8(_mm_min_epu8(x, ct), x));
+        mask = (unsigned int)_mm_movemask_epi8(m);
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+
+LEPT_SIMD_KERNEL("avx2")
+static const char* lept_scan_string_avx2(const char* p, const char* end) {
+    const __m256i qt = _mm256_set1_epi8('\"');
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i ct = _mm256_set1_epi8(0x1F);
+    size_t off = (size_t)p & 31;
+    const char* b = p - off;
+    unsigned int mask;
+    __m256i x, m;
+
+    if (p == end) {
+        return p;
+    }
+
+    x = _mm256_load_si256((const __m256i*)b);
+    m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, qt), _mm256_cmpeq_epi8(x, bs)),
+                        _mm256_cmpeq_epi8(_mm256_min_epu8(x, ct), x));
+    mask = (unsigned int)_mm256_movemask_epi8(m) & (0xFFFFFFFFu << off);
+    while (mask == 0) {
+        b += 32;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x = _mm256_load_si256((const __m256i*)b);
+        m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, qt), _mm256_cmpeq_epi8(x, bs)),
+                            _mm256_cmpeq_epi8(_mm256_min_epu8(x, ct), x));
+        mask = (unsigned int)_mm256_movemask_epi8(m);
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+#endif /* LEPT_SIMD_X86 */
+
+/*
+ * structure kernels: return the first byte at or after p that is '\"', one
+ * of "[]{}" or the '\0' terminator, or end as for whitespace. They carry the
+ * skip over values nobody asked for past everything else in bulk.
+ */
+static const char* lept_scan_structure_scalar(const char* p, const char* end) {
+    while (p != end && *p != '\"' && *p != '[' && *p != ']' && *p != '{' && *p != '}' && *p != '\0') {
+        p++;
+    }
+    return p;
+}
+
+#ifdef LEPT_SIMD_X86
+LEPT_SIMD_KERNEL("sse2")
+static const char* lept_scan_structure_sse2(const char* p, const char* end) {
+    const __m128i qt = _mm_set1_epi8('\"');
+    const __m128i lc = _mm_set1_epi8(0x20);   /* '[' | 0x20 == '{', ']' | 0x20 == '}' */
+    const __m128i ob = _mm_set1_epi8('{');
+    const __m128i cb = _mm_set1_epi8('}');
+    const __m128i nul = _mm_setzero_si128();
+    size_t off = (size_t)p & 15;
+    const char* b = p - off;
+    unsigned int mask;
+    __m128i x, y, m;
+
+    if (p == end) {
+        return p;
+    }
+
+    x = _mm_load_si128((const __m128i*)b);
+    y = _mm_or_si128(x, lc);
+    m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, qt), _mm_cmpeq_epi8(x, nul)),
+                     _mm_or_si128(_mm_cmpeq_epi8(y, ob), _mm_cmpeq_epi8(y, cb)));
+    mask = (unsigned int)_mm_movemask_epi8(m) & (0xFFFFu << off);
+    while (mask == 0) {
+        b += 16;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x = _mm_load_si128((const __m128i*)b);
+        y = _mm_or_si128(x, lc);
+        m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, qt), _mm_cmpeq_epi8(x, nul)),
+                         _mm_or_si128(_mm_cmpeq_epi8(y, ob), _mm_cmpeq_epi8(y, cb)));
+        mask = (unsigned int)_mm_movemask_epi8(m);
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+
+LEPT_SIMD_KERNEL("avx2")
+static const char* lept_scan_structure_avx2(const char* p, const char* end) {
+    const __m256i qt = _mm256_set1_epi8('\"');
+    const __m256i lc = _mm256_set1_epi8(0x20);
+    const __m256i ob = _mm256_set1_epi8('{');
+    const __m256i cb = _mm256_set1_epi8('}');
+    const __m256i nul = _mm256_setzero_si256();
+    size_t off = (size_t)p & 31;
+    const char* b = p - off;
+    unsigned int mask;
+    __m256i x, y, m;
+
+    if (p == end) {
+        return p;
+    }
+
+    x = _mm256_load_si256((const __m256i*)b);
+    y = _mm256_or_si256(x, lc);
+    m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, qt), _mm256_cmpeq_epi8(x, nul)),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(y, ob), _mm256_cmpeq_epi8(y, cb)));
+    mask = (unsigned int)_mm256_movemask_epi8(m) & (0xFFFFFFFFu << off);
+    while (mask == 0) {
+        b += 32;
+        if (end != NULL && b >= end) {
+            return end;
+        }
+        x = _mm256_load_si256((const __m256i*)b);
+        y = _mm256_or_si256(x, lc);
+        m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, qt), _mm256_cmpeq_epi8(x, nul)),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(y, ob), _mm256_cmpeq_epi8(y, cb)));
+        mask = (unsigned int)_mm256_movemask_epi8(m);
+    }
+    p = b + __builtin_ctz(mask);
+    return (end != NULL && p > end) ? end : p;
+}
+#endif /* LEPT_SIMD_X86 */
+
+/*
+ * utf-8 kernels: whether the n bytes at p are well-formed UTF-8 (RFC 3629:
+ * no overlong forms, surrogates or code points past U+10FFFF). Strings are
+ * checked a run of plain characters at a time; a run ends before an ASCII
+ * byte, so a sequence is never split between two calls.
+ */
+typedef int (*lept_utf8_func)(const char* p, size_t n);
+
+/* just past the sequence at p, or NULL if it is ill-formed or cut by end */
+static const unsigned char* lept_utf8_sequence(const unsigned char* p, const unsigned char* end) {
+    unsigned char lo = 0x80, hi = 0xBF;
+    size_t n;
+    if (*p < 0x80) {
+        return p + 1;
+    }
+    if (*p < 0xC2 || *p > 0xF4) {
+        return NULL;
+    }
+    n = (*p < 0xE0) ? 1 : (*p < 0xF0) ? 2 : 3;
+    switch (*p) {
+        case 0xE0: lo = 0xA0; break;    /* overlong */
+        case 0xED: hi = 0x9F; break;    /* surrogates */
+        case 0xF0: lo = 0x90; break;    /* overlong */
+        case 0xF4: hi = 0x8F; break;    /* past U+10FFFF */
+    }
+    if ((size_t)(end - p) <= n || p[1] < lo || p[1] > hi) {
+        return NULL;
+    }
+    for (p += 2; n > 1; n--, p++) {
+        if ((*p & 0xC0) != 0x80) {
+            return NULL;
+        }
+    }
+    return p;
+}
+
+static int lept_validate_utf8_scalar(const char* p, size_t n) {
+    const unsigned char* s = (const unsigned char*)p, * end = s + n;
+    while (s != end) {
+        if ((s = lept_utf8_sequence(s, end)) == NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#ifdef LEPT_SIMD_X86
+/* SSE2 has no byte shuffle for the lookups below: skip ASCII a block at a time */
+LEPT_SIMD_KERNEL("sse2")
+static int lept_validate_utf8_sse2(const char* p, size_t n) {
+    const unsigned char* s = (const unsigned char*)p, * end = s + n;
+    for (;;) {
+        while (end - s >= 16 && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)s)) == 0) {
+            s += 16;
+        }
+        if (s == end) {
+            return 1;
+        }
+        if ((s = lept_utf8_sequence(s, end)) == NULL) {
+            return 0;
+        }
+    }
+}
+
+/*
+ * AVX2: the lookup algorithm of Keiser and Lemire. The high nibble and low
+ * nibble of each byte and the high nibble of the next one each index a table
+ * of the error classes they can take part in; a pair is ill-formed where all
+ * three agree. Third and fourth bytes are matched against their lead bytes
+ * separately, and a block of pure ASCII only has to finish the sequence the
+ * previous block left open.
+ */
+enum {
+    LEPT_UTF8_TOO_SHORT      = 1 << 0,  /* lead not followed by a continuation */
+    LEPT_UTF8_TOO_LONG       = 1 << 1,  /* ASCII followed by a continuation */
+    LEPT_UTF8_OVERLONG_3     = 1 << 2,
+    LEPT_UTF8_TOO_LARGE      = 1 << 3,
+    LEPT_UTF8_SURROGATE      = 1 << 4,
+    LEPT_UTF8_OVERLONG_2     = 1 << 5,
+    LEPT_UTF8_TOO_LARGE_1000 = 1 << 6,
+    LEPT_UTF8_OVERLONG_4     = 1 << 6,
+    LEPT_UTF8_TWO_CONTS      = 1 << 7,  /* a continuation after another, checked by length */
+    LEPT_UTF8_CARRY          = LEPT_UTF8_TOO_SHORT | LEPT_UTF8_TOO_LONG | LEPT_UTF8_TWO_CONTS
+};
+
+#define LEPT_UTF8_TABLE(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+    _mm256_setr_epi8((char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+                     (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p), \
+                     (char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+                     (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p))
+
+/* 32 bytes at lept_utf8_window + 32 - n keep the first n of a block */
+static const unsigned char lept_utf8_window[64] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+LEPT_SIMD_KERNEL("avx2")
+static int lept_validate_utf8_avx2(const char* p, size_t n) {
+    const __m256i byte_1_high = LEPT_UTF8_TABLE(
+        LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG,
+        LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG,
+        LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS,
+        LEPT_UTF8_TOO_SHORT | LEPT_UTF8_OVERLONG_2,
+        LEPT_UTF8_TOO_SHORT,
+        LEPT_UTF8_TOO_SHORT | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_SURROGATE,
+        LEPT_UTF8_TOO_SHORT | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000 | LEPT_UTF8_OVERLONG_4);
+    const __m256i byte_1_low = LEPT_UTF8_TABLE(
+        LEPT_UTF8_CARRY | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_OVERLONG_4,
+        LEPT_UTF8_CARRY | LEPT_UTF8_OVERLONG_2,
+        LEPT_UTF8_CARRY,
+        LEPT_UTF8_CARRY,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000 | LEPT_UTF8_SURROGATE,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000,
+        LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_TOO_LARGE_1000);
+    const __m256i byte_2_high = LEPT_UTF8_TABLE(
+        LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT,
+        LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT,
+        LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_OVERLONG_3 |
+            LEPT_UTF8_TOO_LARGE_1000 | LEPT_UTF8_OVERLONG_4,
+        LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_TOO_LARGE,
+        LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_SURROGATE | LEPT_UTF8_TOO_LARGE,
+        LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_SURROGATE | LEPT_UTF8_TOO_LARGE,
+        LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT);
+    /* bytes at the end of a block that still want continuations in the next */
+    const __m256i max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF, (char)0xDF, (char)0xBF);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i high = _mm256_set1_epi8((char)0x80);
+    __m256i prev_input = _mm256_setzero_si256(), error = prev_input, incomplete = prev_input;
+    __m256i input, prev1, prev2, prev3, special, must23;
+    char tail[32];
+
+    for (;;) {
+        if (n >= 32) {
+            input = _mm256_loadu_si256((const __m256i*)p);
+        }else {
+            if (n == 0) {
+                break;
+            }
+            if (((size_t)p & 4095) <= 4096 - 32) {
+                /* the load stays in the page of p: zero what it reads past n */
+                input = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)p),
+                                         _mm256_loadu_si256((const __m256i*)(lept_utf8_window + 32 - n)));
+            }else {
+                memset(tail, 0, sizeof(tail));
+                memcpy(tail, p, n);
+                input = _mm256_loadu_si256((const __m256i*)tail);
+            }
+        }
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, incomplete);
+            incomplete = _mm256_setzero_si256();
+        }else {
+            /* the bytes 1, 2 and 3 places back, reaching into the previous block */
+            prev3 = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            prev1 = _mm256_alignr_epi8(input, prev3, 15);
+            prev2 = _mm256_alignr_epi8(input, prev3, 14);
+            prev3 = _mm256_alignr_epi8(input, prev3, 13);
+            special = _mm256_and_si256(_mm256_and_si256(
+                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble))),
+                _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+            must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                                     _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(_mm256_and_si256(must23, high), special));
+            incomplete = _mm256_subs_epu8(input, max_value);
+        }
+        prev_input = input;
+        if (n <= 32) {
+            break;
+        }
+        p += 32;
+        n -= 32;
+    }
+    error = _mm256_or_si256(error, incomplete);
+    return _mm256_testz_si256(error, error);
+}
+#undef LEPT_UTF8_TABLE
+#endif /* LEPT_SIMD_X86 */
+
+/*
+ * block classifiers: bitmaps of the 64 bytes at p, bit i for p[i].
+ * m[0]: '\\', m[1]: '\"', m[2]: whitespace, m[3]: one of "{}[]:,", m[4]: '\0'.
+ * Like the word loads, the blocks may run past the terminator within its page.
+ */
+typedef void (*lept_classify_func)(const char* p, lept_uint64* m);
+
+LEPT_WORD_LOAD
+static void lept_classify_scalar(const char* p, lept_uint64* m) {
+    int i;
+    m[0] = m[1] = m[2] = m[3] = m[4] = 0;
+    for (i = 63; i >= 0; i--) {
+        char ch = p[i];
+        m[0] = (m[0] << 1) | (ch == '\\');
+        m[1] = (m[1] << 1) | (ch == '\"');
+        m[2] = (m[2] << 1) | IS_WHITESPACE(ch);
+        m[3] = (m[3] << 1) | (ch == '{' || ch == '}' || ch == '[' || ch == ']' || ch == ':' || ch == ',');
+        m[4] = (m[4] << 1) | (ch == '\0');
+    }
+}
+
+#ifdef LEPT_SIMD_X86
+LEPT_SIMD_KERNEL("sse2")
+static void lept_classify_sse2(const char* p, lept_uint64* m) {
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i qt = _mm_set1_epi8('\"');
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i ht = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i lc = _mm_set1_epi8(0x20);   /* '[' | 0x20 == '{', ']' | 0x20 == '}' */
+    const __m128i ob = _mm_set1_epi8('{');
+    const __m128i cb = _mm_set1_epi8('}');
+    const __m128i cl = _mm_set1_epi8(':');
+    const __m128i cm = _mm_set1_epi8(',');
+    const __m128i nul = _mm_setzero_si128();
+    int i;
+    m[0] = m[1] = m[2] = m[3] = m[4] = 0;
+    for (i = 48; i >= 0; i -= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i y = _mm_or_si128(x, lc);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, ht)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, cr), _mm_cmpeq_epi8(x, lf)));
+        __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(y, ob), _mm_cmpeq_epi8(y, cb)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, cl), _mm_cmpeq_epi8(x, cm)));
+        m[0] = (m[0] << 16) | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(x, bs));
+        m[1] = (m[1] << 16) | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(x, qt));
+        m[2] = (m[2] << 16) | (unsigned int)_mm_movemask_epi8(ws);
+        m[3] = (m[3] << 16) | (unsigned int)_mm_movemask_epi8(op);
+        m[4] = (m[4] << 16) | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(x, nul));
+    }
+}
+
+LEPT_SIMD_KERNEL("avx2")
+static void lept_classify_avx2(const char* p, lept_uint64* m) {
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i qt = _mm256_set1_epi8('\"');
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i ht = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i lc = _mm256_set1_epi8(0x20);
+    const __m256i ob = _mm256_set1_epi8('{');
+    const __m256i cb = _mm256_set1_epi8('}');
+    const __m256i cl = _mm256_set1_epi8(':');
+    const __m256i cm = _mm256_set1_epi8(',');
+    const __m256i nul = _mm256_setzero_si256();
+    int i;
+    m[0] = m[1] = m[2] = m[3] = m[4] = 0;
+    for (i = 32; i >= 0; i -= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i y = _mm256_or_si256(x, lc);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, ht)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(x, cr), _mm256_cmpeq_epi8(x, lf)));
+        __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(y, ob), _mm256_cmpeq_epi8(y, cb)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(x, cl), _mm256_cmpeq_epi8(x, cm)));
+        m[0] = (m[0] << 32) | (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, bs));
+        m[1] = (m[1] << 32) | (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, qt));
+        m[2] = (m[2] << 32) | (unsigned int)_mm256_movemask_epi8(ws);
+        m[3] = (m[3] << 32) | (unsigned int)_mm256_movemask_epi8(op);
+        m[4] = (m[4] << 32) | (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, nul));
+    }
+}
+#endif /* LEPT_SIMD_X86 */
+
+/* runtime dispatch: kernels are resolved on first use, or by lept_set_simd() */
+static const char* lept_skip_whitespace_resolve(const char* p, const char* end);
+static const char* lept_scan_string_resolve(const char* p, const char* end);
+static const char* lept_scan_structure_resolve(const char* p, const char* end);
+static int lept_validate_utf8_resolve(const char* p, size_t n);
+static void lept_classify_resolve(const char* p, lept_uint64* m);
+
+static int lept_simd_level = -1;
+static lept_skip_func lept_skip_whitespace_impl = lept_skip_whitespace_resolve;
+static lept_skip_func lept_scan_string_impl = lept_scan_string_resolve;
+static lept_skip_func lept_scan_structure_impl = lept_scan_structure_resolve;
+static lept_utf8_func lept_validate_utf8_impl = lept_validate_utf8_resolve;
+static lept_classify_func lept_classify_impl = lept_classify_resolve;
+
+static int lept_simd_detect(void) {
+#ifdef LEPT_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return LEPT_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return LEPT_SIMD_SSE2;
+    }
+#endif
+    return LEPT_SIMD_NONE;
+}
+
+static void lept_simd_select(int level) {
+    switch (level) {
+#ifdef LEPT_SIMD_X86
+        case LEPT_SIMD_AVX2:
+            lept_skip_whitespace_impl = lept_skip_whitespace_avx2;
+            lept_scan_string_impl = lept_scan_string_avx2;
+            lept_scan_structure_impl = lept_scan_structure_avx2;
+            lept_validate_utf8_impl = lept_validate_utf8_avx2;
+            lept_classify_impl = lept_classify_avx2;
+            break;
+        case LEPT_SIMD_SSE2:
+            lept_skip_whitespace_impl = lept_skip_whitespace_sse2;
+            lept_scan_string_impl = lept_scan_string_sse2;
+            lept_scan_structure_impl = lept_scan_structure_sse2;
+            lept_validate_utf8_impl = lept_validate_utf8_sse2;
+            lept_classify_impl = lept_classify_sse2;
+            break;
+#endif
+        default:
+            level = LEPT_SIMD_NONE;
+            lept_skip_whitespace_impl = lept_skip_whitespace_scalar;
+            lept_scan_string_impl = lept_scan_string_scalar;
+            lept_scan_structure_impl = lept_scan_structure_scalar;
+            lept_validate_utf8_impl = lept_validate_utf8_scalar;
+            lept_classify_impl = lept_classify_scalar;
+            break;
+    }
+    lept_simd_level = level;
+}
+
+/*
+ * the kernels are picked once. With GCC and Clang that is when the library
+ * is loaded, before any thread can call it; elsewhere it is the first use,
+ * under pthread_once() when there are threads, so threads that meet the
+ * resolvers at the same time wait for one choice instead of racing to
+ * write it. Only lept_set_simd() writes the pointers after that.
+ */
+static void lept_simd_init(void) {
+    lept_simd_select(lept_simd_detect());
+}
+
+#ifdef LEPT_THREADS
+static pthread_once_t lept_simd_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void lept_simd_resolve(void) {
+#ifdef LEPT_THREADS
+    pthread_once(&lept_simd_once, lept_simd_init);
+#else
+    if (lept_simd_level < 0) {
+        lept_simd_init();
+    }
+#endif
+}
+
+#if defined(__GNUC__)
+__attribute__((constructor)) static void lept_simd_startup(void) {
+    lept_simd_resolve();
+}
+#endif
+
+static const char* lept_skip_whitespace_resolve(const char* p, const char* end) {
+    lept_simd_resolve();
+    return lept_skip_whitespace_impl(p, end);
+}
+
+static const char* lept_scan_string_resolve(const char* p, const char* end) {
+    lept_simd_resolve();
+    return lept_scan_string_impl(p, end);
+}
+
+static const char* lept_scan_structure_resolve(const char* p, const char* end) {
+    lept_simd_resolve();
+    return lept_scan_structure_impl(p, end);
+}
+
+static int lept_validate_utf8_resolve(const char* p, size_t n) {
+    lept_simd_resolve();
+    return lept_validate_utf8_impl(p, n);
+}
+
+static void lept_classify_resolve(const char* p, lept_uint64* m) {
+    lept_simd_resolve();
+    lept_classify_impl(p, m);
+}
+
+int lept_get_simd(void) {
+    lept_simd_resolve();
+    return lept_simd_level;
+}
+
+int lept_set_simd(int level) {
+    int max = lept_simd_detect();
+    /* resolved first, so the first use cannot undo the choice later */
+    lept_simd_resolve();
+    lept_simd_select(level < max ? level : max);
+    return lept_simd_level;
+}
+
+static void lept_parse_whitespace(lept_context* c) {
+    const char *p = c->json;
+    /* most gaps between tokens are zero or one byte: skip the kernel call */
+    if (!IS_WHITESPACE(PEEK(c, p))) {
+        return;
+    }
+    if (!IS_WHITESPACE(PEEK(c, p + 1))) {
+        c->json = p + 1;
+        return;
+    }
+    c->json = lept_skip_whitespace_impl(p + 2, c->end);
+}
+
+/* the 4 bytes at p, which may run past the terminator of json but not past its page */
+LEPT_WORD_LOAD
+static void lept_load_word(const char* p, char* w) {
+    memcpy(w, p, 4);
+}
+
+static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
+    const char* p = c->json;
+    size_t i, len = (type == LEPT_FALSE) ? 5 : 4;
+    char w[4];
+    assert(*p == literal[0] && len == strlen(literal));
+    if (c->end != NULL ? (size_t)(c->end - p) >= len : ((size_t)p & 4095) <= 4096 - 4) {
+        /* one word compare; a match holds no '\0', so nothing past the input counts */
+        lept_load_word(p, w);
+        if (memcmp(w, literal, 4) != 0 || (len == 5 && p[4] != literal[4])) {
+            return LEPT_PARSE_INVALID_VALUE;
+        }
+    }else {
+        for (i = 1; i < len; i++) {
+            if (PEEK(c, p + i) != literal[i]) {
+                return LEPT_PARSE_INVALID_VALUE;
+            }
+        }
+    }
+    c->json = p + len;
+    v->type = type;
+    return LEPT_PARSE_OK;
+}
+
+/* what the first byte of a value makes it, for a dense switch in the engines */
+enum {
+    LEPT_CLASS_INVALID, LEPT_CLASS_END, LEPT_CLASS_NULL, LEPT_CLASS_TRUE, LEPT_CLASS_FALSE,
+    LEPT_CLASS_STRING, LEPT_CLASS_OPEN, LEPT_CLASS_NUMBER
+};
+
+#define X LEPT_CLASS_INVALID
+#define E LEPT_CLASS_END
+#define N LEPT_CLASS_NULL
+#define T LEPT_CLASS_TRUE
+#define F LEPT_CLASS_FALSE
+#define S LEPT_CLASS_STRING
+#define O LEPT_CLASS_OPEN
+#define D LEPT_CLASS_NUMBER
+static const unsigned char lept_value_class[256] = {
+    E, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* 00 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* 10 */
+    X, X, S, X, X, X, X, X, X, X, X, X, X, D, X, X,  /* 20 */
+    D, D, D, D, D, D, D, D, D, D, X, X, X, X, X, X,  /* 30 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* 40 */
+    X, X, X, X, X, X, X, X, X, X, X, O, X, X, X, X,  /* 50 */
+    X, X, X, X, X, X, F, X, X, X, X, X, X, X, N, X,  /* 60 */
+    X, X, X, X, T, X, X, X, X, X, X, O, X, X, X, X,  /* 70 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* 80 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* 90 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* A0 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* B0 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* C0 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* D0 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,  /* E0 */
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X  /* F0 */
+};
+#undef X
+#undef E
+#undef N
+#undef T
+#undef F
+#undef S
+#undef O
+#undef D
+
+/*
+ * number: the literal is validated and its decimal significand w (at most 19
+ * digits) and exponent q are accumulated in the same pass, so that the value
+ * is w * 10^q. Conversion to double then tries, in order:
+ *   - Clinger's fast path: w and 10^q are both exact doubles, one rounding;
+ *   - Eisel-Lemire: a 128-bit truncated product with 5^q decides the rounding
+ *     in almost every case;
+ *   - strtod() on a copy of the text with the locale's decimal point, for
+ *     the rare literals left over.
+ */
+#define LEPT_POW5_MIN_EXP (-342)
+#define LEPT_POW5_MAX_EXP 308
+
+/* 128-bit normalized approximations of 5^q for q in [-342, 308], high word first */
+static const lept_uint64 lept_pow5_128[] = {
+    LEPT_U64(0xeef453d6, 0x923bd65a), LEPT_U64(0x113faa29, 0x06a13b3f),
+    LEPT_U64(0x9558b466, 0x1b6565f8), LEPT_U64(0x4ac7ca59, 0xa424c507),
+    LEPT_U64(0xbaaee17f, 0xa23ebf76), LEPT_U64(0x5d79bcf0, 0x0d2df649),
+    LEPT_U64(0xe95a99df, 0x8ace6f53), LEPT_U64(0xf4d82c2c, 0x107973dc),
+    LEPT_U64(0x91d8a02b, 0xb6c10594), LEPT_U64(0x79071b9b, 0x8a4be869),
+    LEPT_U64(0xb64ec836, 0xa47146f9), LEPT_U64(0x9748e282, 0x6cdee284),
+    LEPT_U64(0xe3e27a44, 0x4d8d98b7), LEPT_U64(0xfd1b1b23, 0x08169b25),
+    LEPT_U64(0x8e6d8c6a, 0xb0787f72), LEPT_U64(0xfe30f0f5, 0xe50e20f7),
+    LEPT_U64(0xb208ef85, 0x5c969f4f), LEPT_U64(0xbdbd2d33, 0x5e51a935),
+    LEPT_U64(0xde8b2b66, 0xb3bc4723), LEPT_U64(0xad2c7880, 0x35e61382),
+    LEPT_U64(0x8b16fb20, 0x3055ac76), LEPT_U64(0x4c3bcb50, 0x21afcc31),
+    LEPT_U64(0xaddcb9e8, 0x3c6b1793), LEPT_U64(0xdf4abe24, 0x2a1bbf3d),
+    LEPT_U64(0xd953e862, 0x4b85dd78), LEPT_U64(0xd71d6dad, 0x34a2af0d),
+    LEPT_U64(0x87d4713d, 0x6f33aa6b), LEPT_U64(0x8672648c, 0x40e5ad68),
+    LEPT_U64(0xa9c98d8c, 0xcb009506), LEPT_U64(0x680efdaf, 0x511f18c2),
+    LEPT_U64(0xd43bf0ef, 0xfdc0ba48), LEPT_U64(0x0212bd1b, 0x2566def2),
+    LEPT_U64(0x84a57695, 0xfe98746d), LEPT_U64(0x014bb630, 0xf7604b57),
+    LEPT_U64(0xa5ced43b, 0x7e3e9188), LEPT_U64(0x419ea3bd, 0x35385e2d),
+    LEPT_U64(0xcf42894a, 0x5dce35ea), LEPT_U64(0x52064cac, 0x828675b9),
+    LEPT_U64(0x818995ce, 0x7aa0e1b2), LEPT_U64(0x7343efeb, 0xd1940993),
+    LEPT_U64(0xa1ebfb42, 0x19491a1f), LEPT_U64(0x1014ebe6, 0xc5f90bf8),
+    LEPT_U64(0xca66fa12, 0x9f9b60a6), LEPT_U64(0xd41a26e0, 0x77774ef6),
+    LEPT_U64(0xfd00b897, 0x478238d0), LEPT_U64(0x8920b098, 0x955522b4),
+    LEPT_U64(0x9e20735e, 0x8cb16382), LEPT_U64(0x55b46e5f, 0x5d5535b0),
+    LEPT_U64(0xc5a89036, 0x2fddbc62), LEPT_U64(0xeb2189f7, 0x34aa831d),
+    LEPT_U64(0xf712b443, 0xbbd52b7b), LEPT_U64(0xa5e9ec75, 0x01d523e4),
+    LEPT_U64(0x9a6bb0aa, 0x55653b2d), LEPT_U64(0x47b233c9, 0x2125366e),
+    LEPT_U64(0xc1069cd4, 0xeabe89f8), LEPT_U64(0x999ec0bb, 0x696e840a),
+    LEPT_U64(0xf148440a, 0x256e2c76), LEPT_U64(0xc00670ea, 0x43ca250d),
+    LEPT_U64(0x96cd2a86, 0x5764dbca), LEPT_U64(0x38040692, 0x6a5e5728),
+    LEPT_U64(0xbc807527, 0xed3e12bc), LEPT_U64(0xc6050837, 0x04f5ecf2),
+    LEPT_U64(0xeba09271, 0xe88d976b), LEPT_U64(0xf7864a44, 0xc633682e),
+    LEPT_U64(0x93445b87, 0x31587ea3), LEPT_U64(0x7ab3ee6a, 0xfbe0211d),
+    LEPT_U64(0xb8157268, 0xfdae9e4c), LEPT_U64(0x5960ea05, 0xbad82964),
+    LEPT_U64(0xe61acf03, 0x3d1a45df), LEPT_U64(0x6fb92487, 0x298e33bd),
+    LEPT_U64(0x8fd0c162, 0x06306bab), LEPT_U64(0xa5d3b6d4, 0x79f8e056),
+    LEPT_U64(0xb3c4f1ba, 0x87bc8696), LEPT_U64(0x8f48a489, 0x9877186c),
+    LEPT_U64(0xe0b62e29, 0x29aba83c), LEPT_U64(0x331acdab, 0xfe94de87),
+    LEPT_U64(0x8c71dcd9, 0xba0b4925), LEPT_U64(0x9ff0c08b, 0x7f1d0b14),
+    LEPT_U64(0xaf8e5410, 0x288e1b6f), LEPT_U64(0x07ecf0ae, 0x5ee44dd9),
+    LEPT_U64(0xdb71e914, 0x32b1a24a), LEPT_U64(0xc9e82cd9, 0xf69d6150),
+    LEPT_U64(0x892731ac, 0x9faf056e), LEPT_U64(0xbe311c08, 0x3a225cd2),
+    LEPT_U64(0xab70fe17, 0xc79ac6ca), LEPT_U64(0x6dbd630a, 0x48aaf406),
+    LEPT_U64(0xd64d3d9d, 0xb981787d), LEPT_U64(0x092cbbcc, 0xdad5b108),
+    LEPT_U64(0x85f04682, 0x93f0eb4e), LEPT_U64(0x25bbf560, 0x08c58ea5),
+    LEPT_U64(0xa76c5823, 0x38ed2621), LEPT_U64(0xaf2af2b8, 0x0af6f24e),
+    LEPT_U64(0xd1476e2c, 0x07286faa), LEPT_U64(0x1af5af66, 0x0db4aee1),
+    LEPT_U64(0x82cca4db, 0x847945ca), LEPT_U64(0x50d98d9f, 0xc890ed4d),
+    LEPT_U64(0xa37fce12, 0x6597973c), LEPT_U64(0xe50ff107, 0xbab528a0),
+    LEPT_U64(0xcc5fc196, 0xfefd7d0c), LEPT_U64(0x1e53ed49, 0xa96272c8),
+    LEPT_U64(0xff77b1fc, 0xbebcdc4f), LEPT_U64(0x25e8e89c, 0x13bb0f7a),
+    LEPT_U64(0x9faacf3d, 0xf73609b1), LEPT_U64(0x77b19161, 0x8c54e9ac),
+    LEPT_U64(0xc795830d, 0x75038c1d), LEPT_U64(0xd59df5b9, 0xef6a2417),
+    LEPT_U64(0xf97ae3d0, 0xd2446f25), LEPT_U64(0x4b057328, 0x6b44ad1d),
+    LEPT_U64(0x9becce62, 0x836ac577), LEPT_U64(0x4ee367f9, 0x430aec32),
+    LEPT_U64(0xc2e801fb, 0x244576d5), LEPT_U64(0x229c41f7, 0x93cda73f),
+    LEPT_U64(0xf3a20279, 0xed56d48a), LEPT_U64(0x6b435275, 0x78c1110f),
+    LEPT_U64(0x9845418c, 0x345644d6), LEPT_U64(0x830a1389, 0x6b78aaa9),
+    LEPT_U64(0xbe5691ef, 0x416bd60c), LEPT_U64(0x23cc986b, 0xc656d553),
+    LEPT_U64(0xedec366b, 0x11c6cb8f), LEPT_U64(0x2cbfbe86, 0xb7ec8aa8),
+    LEPT_U64(0x94b3a202, 0xeb1c3f39), LEPT_U64(0x7bf7d714, 0x32f3d6a9),
+    LEPT_U64(0xb9e08a83, 0xa5e34f07), LEPT_U64(0xdaf5ccd9, 0x3fb0cc53),
+    LEPT_U64(0xe858ad24, 0x8f5c22c9), LEPT_U64(0xd1b3400f, 0x8f9cff68),
+    LEPT_U64(0x91376c36, 0xd99995be), LEPT_U64(0x23100809, 0xb9c21fa1),
+    LEPT_U64(0xb5854744, 0x8ffffb2d), LEPT_U64(0xabd40a0c, 0x2832a78a),
+    LEPT_U64(0xe2e69915, 0xb3fff9f9), LEPT_U64(0x16c90c8f, 0x323f516c),
+    LEPT_U64(0x8dd01fad, 0x907ffc3b), LEPT_U64(0xae3da7d9, 0x7f6792e3),
+    LEPT_U64(0xb1442798, 0xf49ffb4a), LEPT_U64(0x99cd11cf, 0xdf41779c),
+    LEPT_U64(0xdd95317f, 0x31c7fa1d), LEPT_U64(0x40405643, 0xd711d583),
+    LEPT_U64(0x8a7d3eef, 0x7f1cfc52), LEPT_U64(0x482835ea, 0x666b2572),
+    LEPT_U64(0xad1c8eab, 0x5ee43b66), LEPT_U64(0xda324365, 0x0005eecf),
+    LEPT_U64(0xd863b256, 0x369d4a40), LEPT_U64(0x90bed43e, 0x40076a82),
+    LEPT_U64(0x873e4f75, 0xe2224e68), LEPT_U64(0x5a7744a6, 0xe804a291),
+    LEPT_U64(0xa90de353, 0x5aaae202), LEPT_U64(0x711515d0, 0xa205cb36),
+    LEPT_U64(0xd3515c28, 0x31559a83), LEPT_U64(0x0d5a5b44, 0xca873e03),
+    LEPT_U64(0x8412d999, 0x1ed58091), LEPT_U64(0xe858790a, 0xfe9486c2),
+    LEPT_U64(0xa5178fff, 0x668ae0b6), LEPT_U64(0x626e974d, 0xbe39a872),
+    LEPT_U64(0xce5d73ff, 0x402d98e3), LEPT_U64(0xfb0a3d21, 0x2dc8128f),
+    LEPT_U64(0x80fa687f, 0x881c7f8e), LEPT_U64(0x7ce66634, 0xbc9d0b99),
+    LEPT_U64(0xa139029f, 0x6a239f72), LEPT_U64(0x1c1fffc1, 0xebc44e80),
+    LEPT_U64(0xc9874347, 0x44ac874e), LEPT_U64(0xa327ffb2, 0x66b56220),
+    LEPT_U64(0xfbe91419, 0x15d7a922), LEPT_U64(0x4bf1ff9f, 0x0062baa8),
+    LEPT_U64(0x9d71ac8f, 0xada6c9b5), LEPT_U64(0x6f773fc3, 0x603db4a9),
+    LEPT_U64(0xc4ce17b3, 0x99107c22), LEPT_U64(0xcb550fb4, 0x384d21d3),
+    LEPT_U64(0xf6019da0, 0x7f549b2b), LEPT_U64(0x7e2a53a1, 0x46606a48),
+    LEPT_U64(0x99c10284, 0x4f94e0fb), LEPT_U64(0x2eda7444, 0xcbfc426d),
+    LEPT_U64(0xc0314325, 0x637a1939), LEPT_U64(0xfa911155, 0xfefb5308),
+    LEPT_U64(0xf03d93ee, 0xbc589f88), LEPT_U64(0x793555ab, 0x7eba27ca),
+    LEPT_U64(0x96267c75, 0x35b763b5), LEPT_U64(0x4bc1558b, 0x2f3458de),
+    LEPT_U64(0xbbb01b92, 0x83253ca2), LEPT_U64(0x9eb1aaed, 0xfb016f16),
+    LEPT_U64(0xea9c2277, 0x23ee8bcb), LEPT_U64(0x465e15a9, 0x79c1cadc),
+    LEPT_U64(0x92a1958a, 0x7675175f), LEPT_U64(0x0bfacd89, 0xec191ec9),
+    LEPT_U64(0xb749faed, 0x14125d36), LEPT_U64(0xcef980ec, 0x671f667b),
+    LEPT_U64(0xe51c79a8, 0x5916f484), LEPT_U64(0x82b7e127, 0x80e7401a),
+    LEPT_U64(0x8f31cc09, 0x37ae58d2), LEPT_U64(0xd1b2ecb8, 0xb0908810),
+    LEPT_U64(0xb2fe3f0b, 0x8599ef07), LEPT_U64(0x861fa7e6, 0xdcb4aa15),
+    LEPT_U64(0xdfbdcece, 0x67006ac9), LEPT_U64(0x67a791e0, 0x93e1d49a),
+    LEPT_U64(0x8bd6a141, 0x006042bd), LEPT_U64(0xe0c8bb2c, 0x5c6d24e0),
+    LEPT_U64(0xaecc4991, 0x4078536d), LEPT_U64(0x58fae9f7, 0x73886e18),
+    LEPT_U64(0xda7f5bf5, 0x90966848), LEPT_U64(0xaf39a475, 0x506a899e),
+    LEPT_U64(0x888f9979, 0x7a5e012d), LEPT_U64(0x6d8406c9, 0x52429603),
+    LEPT_U64(0xaab37fd7, 0xd8f58178), LEPT_U64(0xc8e5087b, 0xa6d33b83),
+    LEPT_U64(0xd5605fcd, 0xcf32e1d6), LEPT_U64(0xfb1e4a9a, 0x90880a64),
+    LEPT_U64(0x855c3be0, 0xa17fcd26), LEPT_U64(0x5cf2eea0, 0x9a55067f),
+    LEPT_U64(0xa6b34ad8, 0xc9dfc06f), LEPT_U64(0xf42faa48, 0xc0ea481e),
+    LEPT_U64(0xd0601d8e, 0xfc57b08b), LEPT_U64(0xf13b94da, 0xf124da26),
+    LEPT_U64(0x823c1279, 0x5db6ce57), LEPT_U64(0x76c53d08, 0xd6b70858),
+    LEPT_U64(0xa2cb1717, 0xb52481ed), LEPT_U64(0x54768c4b, 0x0c64ca6e),
+    LEPT_U64(0xcb7ddcdd, 0xa26da268), LEPT_U64(0xa9942f5d, 0xcf7dfd09),
+    LEPT_U64(0xfe5d5415, 0x0b090b02), LEPT_U64(0xd3f93b35, 0x435d7c4c),
+    LEPT_U64(0x9efa548d, 0x26e5a6e1), LEPT_U64(0xc47bc501, 0x4a1a6daf),
+    LEPT_U64(0xc6b8e9b0, 0x709f109a), LEPT_U64(0x359ab641, 0x9ca1091b),
+    LEPT_U64(0xf867241c, 0x8cc6d4c0), LEPT_U64(0xc30163d2, 0x03c94b62),
+    LEPT_U64(0x9b407691, 0xd7fc44f8), LEPT_U64(0x79e0de63, 0x425dcf1d),
+    LEPT_U64(0xc2109436, 0x4dfb5636), LEPT_U64(0x985915fc, 0x12f542e4),
+    LEPT_U64(0xf294b943, 0xe17a2bc4), LEPT_U64(0x3e6f5b7b, 0x17b2939d),
+    LEPT_U64(0x979cf3ca, 0x6cec5b5a), LEPT_U64(0xa705992c, 0xeecf9c42),
+    LEPT_U64(0xbd8430bd, 0x08277231), LEPT_U64(0x50c6ff78, 0x2a838353),
+    LEPT_U64(0xece53cec, 0x4a314ebd), LEPT_U64(0xa4f8bf56, 0x35246428),
+    LEPT_U64(0x940f4613, 0xae5ed136), LEPT_U64(0x871b7795, 0xe136be99),
+    LEPT_U64(0xb9131798, 0x99f68584), LEPT_U64(0x28e2557b, 0x59846e3f),
+    LEPT_U64(0xe757dd7e, 0xc07426e5), LEPT_U64(0x331aeada, 0x2fe589cf),
+    LEPT_U64(0x9096ea6f, 0x3848984f), LEPT_U64(0x3ff0d2c8, 0x5def7621),
+    LEPT_U64(0xb4bca50b, 0x065abe63), LEPT_U64(0x0fed077a, 0x756b53a9),
+    LEPT_U64(0xe1ebce4d, 0xc7f16dfb), LEPT_U64(0xd3e84959, 0x12c62894),
+    LEPT_U64(0x8d3360f0, 0x9cf6e4bd), LEPT_U64(0x64712dd7, 0xabbbd95c),
+    LEPT_U64(0xb080392c, 0xc4349dec), LEPT_U64(0xbd8d794d, 0x96aacfb3),
+    LEPT_U64(0xdca04777, 0xf541c567), LEPT_U64(0xecf0d7a0, 0xfc5583a0),
+    LEPT_U64(0x89e42caa, 0xf9491b60), LEPT_U64(0xf41686c4, 0x9db57244),
+    LEPT_U64(0xac5d37d5, 0xb79b6239), LEPT_U64(0x311c2875, 0xc522ced5),
+    LEPT_U64(0xd77485cb, 0x25823ac7), LEPT_U64(0x7d633293, 0x366b828b),
+    LEPT_U64(0x86a8d39e, 0xf77164bc), LEPT_U64(0xae5dff9c, 0x02033197),
+    LEPT_U64(0xa8530886, 0xb54dbdeb), LEPT_U64(0xd9f57f83, 0x0283fdfc),
+    LEPT_U64(0xd267caa8, 0x62a12d66), LEPT_U64(0xd072df63, 0xc324fd7b),
+    LEPT_U64(0x8380dea9, 0x3da4bc60), LEPT_U64(0x4247cb9e, 0x59f71e6d),
+    LEPT_U64(0xa4611653, 0x8d0deb78), LEPT_U64(0x52d9be85, 0xf074e608),
+    LEPT_U64(0xcd795be8, 0x70516656), LEPT_U64(0x67902e27, 0x6c921f8b),
+    LEPT_U64(0x806bd971, 0x4632dff6), LEPT_U64(0x00ba1cd8, 0xa3db53b6),
+    LEPT_U64(0xa086cfcd, 0x97bf97f3), LEPT_U64(0x80e8a40e, 0xccd228a4),
+    LEPT_U64(0xc8a883c0, 0xfdaf7df0), LEPT_U64(0x6122cd12, 0x8006b2cd),
+    LEPT_U64(0xfad2a4b1, 0x3d1b5d6c), LEPT_U64(0x796b8057, 0x20085f81),
+    LEPT_U64(0x9cc3a6ee, 0xc6311a63), LEPT_U64(0xcbe33036, 0x74053bb0),
+    LEPT_U64(0xc3f490aa, 0x77bd60fc), LEPT_U64(0xbedbfc44, 0x11068a9c),
+    LEPT_U64(0xf4f1b4d5, 0x15acb93b), LEPT_U64(0xee92fb55, 0x15482d44),
+    LEPT_U64(0x99171105, 0x2d8bf3c5), LEPT_U64(0x751bdd15, 0x2d4d1c4a),
+    LEPT_U64(0xbf5cd546, 0x78eef0b6), LEPT_U64(0xd262d45a, 0x78a0635d),
+    LEPT_U64(0xef340a98, 0x172aace4), LEPT_U64(0x86fb8971, 0x16c87c34),
+    LEPT_U64(0x9580869f, 0x0e7aac0e), LEPT_U64(0xd45d35e6, 0xae3d4da0),
+    LEPT_U64(0xbae0a846, 0xd2195712), LEPT_U64(0x89748360, 0x59cca109),
+    LEPT_U64(0xe998d258, 0x869facd7), LEPT_U64(0x2bd1a438, 0x703fc94b),
+    LEPT_U64(0x91ff8377, 0x5423cc06), LEPT_U64(0x7b6306a3, 0x4627ddcf),
+    LEPT_U64(0xb67f6455, 0x292cbf08), LEPT_U64(0x1a3bc84c, 0x17b1d542),
+    LEPT_U64(0xe41f3d6a, 0x7377eeca), LEPT_U64(0x20caba5f, 0x1d9e4a93),
+    LEPT_U64(0x8e938662, 0x882af53e), LEPT_U64(0x547eb47b, 0x7282ee9c),
+    LEPT_U64(0xb23867fb, 0x2a35b28d), LEPT_U64(0xe99e619a, 0x4f23aa43),
+    LEPT_U64(0xdec681f9, 0xf4c31f31), LEPT_U64(0x6405fa00, 0xe2ec94d4),
+    LEPT_U64(0x8b3c113c, 0x38f9f37e), LEPT_U64(0xde83bc40, 0x8dd3dd04),
+    LEPT_U64(0xae0b158b, 0x4738705e), LEPT_U64(0x9624ab50, 0xb148d445),
+    LEPT_U64(0xd98ddaee, 0x19068c76), LEPT_U64(0x3badd624, 0xdd9b0957),
+    LEPT_U64(0x87f8a8d4, 0xcfa417c9), LEPT_U64(0xe54ca5d7, 0x0a80e5d6),
+    LEPT_U64(0xa9f6d30a, 0x038d1dbc), LEPT_U64(0x5e9fcf4c, 0xcd211f4c),
+    LEPT_U64(0xd47487cc, 0x8470652b), LEPT_U64(0x7647c320, 0x0069671f),
+    LEPT_U64(0x84c8d4df, 0xd2c63f3b), LEPT_U64(0x29ecd9f4, 0x0041e073),
+    LEPT_U64(0xa5fb0a17, 0xc777cf09), LEPT_U64(0xf4681071, 0x00525890),
+    LEPT_U64(0xcf79cc9d, 0xb955c2cc), LEPT_U64(0x7182148d, 0x4066eeb4),
+    LEPT_U64(0x81ac1fe2, 0x93d599bf), LEPT_U64(0xc6f14cd8, 0x48405530),
+    LEPT_U64(0xa21727db, 0x38cb002f), LEPT_U64(0xb8ada00e, 0x5a506a7c),
+    LEPT_U64(0xca9cf1d2, 0x06fdc03b), LEPT_U64(0xa6d90811, 0xf0e4851c),
+    LEPT_U64(0xfd442e46, 0x88bd304a), LEPT_U64(0x908f4a16, 0x6d1da663),
+    LEPT_U64(0x9e4a9cec, 0x15763e2e), LEPT_U64(0x9a598e4e, 0x043287fe),
+    LEPT_U64(0xc5dd4427, 0x1ad3cdba), LEPT_U64(0x40eff1e1, 0x853f29fd),
+    LEPT_U64(0xf7549530, 0xe188c128), LEPT_U64(0xd12bee59, 0xe68ef47c),
+    LEPT_U64(0x9a94dd3e, 0x8cf578b9), LEPT_U64(0x82bb74f8, 0x301958ce),
+    LEPT_U64(0xc13a148e, 0x3032d6e7), LEPT_U64(0xe36a5236, 0x3c1faf01),
+    LEPT_U64(0xf18899b1, 0xbc3f8ca1), LEPT_U64(0xdc44e6c3, 0xcb279ac1),
+    LEPT_U64(0x96f5600f, 0x15a7b7e5), LEPT_U64(0x29ab103a, 0x5ef8c0b9),
+    LEPT_U64(0xbcb2b812, 0xdb11a5de), LEPT_U64(0x7415d448, 0xf6b6f0e7),
+    LEPT_U64(0xebdf6617, 0x91d60f56), LEPT_U64(0x111b495b, 0x3464ad21),
+    LEPT_U64(0x936b9fce, 0xbb25c995), LEPT_U64(0xcab10dd9, 0x00beec34),
+    LEPT_U64(0xb84687c2, 0x69ef3bfb), LEPT_U64(0x3d5d514f, 0x40eea742),
+    LEPT_U64(0xe65829b3, 0x046b0afa), LEPT_U64(0x0cb4a5a3, 0x112a5112),
+    LEPT_U64(0x8ff71a0f, 0xe2c2e6dc), LEPT_U64(0x47f0e785, 0xeaba72ab),
+    LEPT_U64(0xb3f4e093, 0xdb73a093), LEPT_U64(0x59ed2167, 0x65690f56),
+    LEPT_U64(0xe0f218b8, 0xd25088b8), LEPT_U64(0x306869c1, 0x3ec3532c),
+    LEPT_U64(0x8c974f73, 0x83725573), LEPT_U64(0x1e414218, 0xc73a13fb),
+    LEPT_U64(0xafbd2350, 0x644eeacf), LEPT_U64(0xe5d1929e, 0xf90898fa),
+    LEPT_U64(0xdbac6c24, 0x7d62a583), LEPT_U64(0xdf45f746, 0xb74abf39),
+    LEPT_U64(0x894bc396, 0xce5da772), LEPT_U64(0x6b8bba8c, 0x328eb783),
+    LEPT_U64(0xab9eb47c, 0x81f5114f), LEPT_U64(0x066ea92f, 0x3f326564),
+    LEPT_U64(0xd686619b, 0xa27255a2), LEPT_U64(0xc80a537b, 0x0efefebd),
+    LEPT_U64(0x8613fd01, 0x45877585), LEPT_U64(0xbd06742c, 0xe95f5f36),
+    LEPT_U64(0xa798fc41, 0x96e952e7), LEPT_U64(0x2c481138, 0x23b73704),
+    LEPT_U64(0xd17f3b51, 0xfca3a7a0), LEPT_U64(0xf75a1586, 0x2ca504c5),
+    LEPT_U64(0x82ef8513, 0x3de648c4), LEPT_U64(0x9a984d73, 0xdbe722fb),
+    LEPT_U64(0xa3ab6658, 0x0d5fdaf5), LEPT_U64(0xc13e60d0, 0xd2e0ebba),
+    LEPT_U64(0xcc963fee, 0x10b7d1b3), LEPT_U64(0x318df905, 0x079926a8),
+    LEPT_U64(0xffbbcfe9, 0x94e5c61f), LEPT_U64(0xfdf17746, 0x497f7052),
+    LEPT_U64(0x9fd561f1, 0xfd0f9bd3), LEPT_U64(0xfeb6ea8b, 0xedefa633),
+    LEPT_U64(0xc7caba6e, 0x7c5382c8), LEPT_U64(0xfe64a52e, 0xe96b8fc0),
+    LEPT_U64(0xf9bd690a, 0x1b68637b), LEPT_U64(0x3dfdce7a, 0xa3c673b0),
+    LEPT_U64(0x9c1661a6, 0x51213e2d), LEPT_U64(0x06bea10c, 0xa65c084e),
+    LEPT_U64(0xc31bfa0f, 0xe5698db8), LEPT_U64(0x486e494f, 0xcff30a62),
+    LEPT_U64(0xf3e2f893, 0xdec3f126), LEPT_U64(0x5a89dba3, 0xc3efccfa),
+    LEPT_U64(0x986ddb5c, 0x6b3a76b7), LEPT_U64(0xf8962946, 0x5a75e01c),
+    LEPT_U64(0xbe895233, 0x86091465), LEPT_U64(0xf6bbb397, 0xf1135823),
+    LEPT_U64(0xee2ba6c0, 0x678b597f), LEPT_U64(0x746aa07d, 0xed582e2c),
+    LEPT_U64(0x94db4838, 0x40b717ef), LEPT_U64(0xa8c2a44e, 0xb4571cdc),
+    LEPT_U64(0xba121a46, 0x50e4ddeb), LEPT_U64(0x92f34d62, 0x616ce413),
+    LEPT_U64(0xe896a0d7, 0xe51e1566), LEPT_U64(0x77b020ba, 0xf9c81d17),
+    LEPT_U64(0x915e2486, 0xef32cd60), LEPT_U64(0x0ace1474, 0xdc1d122e),
+    LEPT_U64(0xb5b5ada8, 0xaaff80b8), LEPT_U64(0x0d819992, 0x132456ba),
+    LEPT_U64(0xe3231912, 0xd5bf60e6), LEPT_U64(0x10e1fff6, 0x97ed6c69),
+    LEPT_U64(0x8df5efab, 0xc5979c8f), LEPT_U64(0xca8d3ffa, 0x1ef463c1),
+    LEPT_U64(0xb1736b96, 0xb6fd83b3), LEPT_U64(0xbd308ff8, 0xa6b17cb2),
+    LEPT_U64(0xddd0467c, 0x64bce4a0), LEPT_U64(0xac7cb3f6, 0xd05ddbde),
+    LEPT_U64(0x8aa22c0d, 0xbef60ee4), LEPT_U64(0x6bcdf07a, 0x423aa96b),
+    LEPT_U64(0xad4ab711, 0x2eb3929d), LEPT_U64(0x86c16c98, 0xd2c953c6),
+    LEPT_U64(0xd89d64d5, 0x7a607744), LEPT_U64(0xe871c7bf, 0x077ba8b7),
+    LEPT_U64(0x87625f05, 0x6c7c4a8b), LEPT_U64(0x11471cd7, 0x64ad4972),
+    LEPT_U64(0xa93af6c6, 0xc79b5d2d), LEPT_U64(0xd598e40d, 0x3dd89bcf),
+    LEPT_U64(0xd389b478, 0x79823479), LEPT_U64(0x4aff1d10, 0x8d4ec2c3),
+    LEPT_U64(0x843610cb, 0x4bf160cb), LEPT_U64(0xcedf722a, 0x585139ba),
+    LEPT_U64(0xa54394fe, 0x1eedb8fe), LEPT_U64(0xc2974eb4, 0xee658828),
+    LEPT_U64(0xce947a3d, 0xa6a9273e), LEPT_U64(0x733d2262, 0x29feea32),
+    LEPT_U64(0x811ccc66, 0x8829b887), LEPT_U64(0x0806357d, 0x5a3f525f),
+    LEPT_U64(0xa163ff80, 0x2a3426a8), LEPT_U64(0xca07c2dc, 0xb0cf26f7),
+    LEPT_U64(0xc9bcff60, 0x34c13052), LEPT_U64(0xfc89b393, 0xdd02f0b5),
+    LEPT_U64(0xfc2c3f38, 0x41f17c67), LEPT_U64(0xbbac2078, 0xd443ace2),
+    LEPT_U64(0x9d9ba783, 0x2936edc0), LEPT_U64(0xd54b944b, 0x84aa4c0d),
+    LEPT_U64(0xc5029163, 0xf384a931), LEPT_U64(0x0a9e795e, 0x65d4df11),
+    LEPT_U64(0xf64335bc, 0xf065d37d), LEPT_U64(0x4d4617b5, 0xff4a16d5),
+    LEPT_U64(0x99ea0196, 0x163fa42e), LEPT_U64(0x504bced1, 0xbf8e4e45),
+    LEPT_U64(0xc06481fb, 0x9bcf8d39), LEPT_U64(0xe45ec286, 0x2f71e1d6),
+    LEPT_U64(0xf07da27a, 0x82c37088), LEPT_U64(0x5d767327, 0xbb4e5a4c),
+    LEPT_U64(0x964e858c, 0x91ba2655), LEPT_U64(0x3a6a07f8, 0xd510f86f),
+    LEPT_U64(0xbbe226ef, 0xb628afea), LEPT_U64(0x890489f7, 0x0a55368b),
+    LEPT_U64(0xeadab0ab, 0xa3b2dbe5), LEPT_U64(0x2b45ac74, 0xccea842e),
+    LEPT_U64(0x92c8ae6b, 0x464fc96f), LEPT_U64(0x3b0b8bc9, 0x0012929d),
+    LEPT_U64(0xb77ada06, 0x17e3bbcb), LEPT_U64(0x09ce6ebb, 0x40173744),
+    LEPT_U64(0xe5599087, 0x9ddcaabd), LEPT_U64(0xcc420a6a, 0x101d0515),
+    LEPT_U64(0x8f57fa54, 0xc2a9eab6), LEPT_U64(0x9fa94682, 0x4a12232d),
+    LEPT_U64(0xb32df8e9, 0xf3546564), LEPT_U64(0x47939822, 0xdc96abf9),
+    LEPT_U64(0xdff97724, 0x70297ebd), LEPT_U64(0x59787e2b, 0x93bc56f7),
+    LEPT_U64(0x8bfbea76, 0xc619ef36), LEPT_U64(0x57eb4edb, 0x3c55b65a),
+    LEPT_U64(0xaefae514, 0x77a06b03), LEPT_U64(0xede62292, 0x0b6b23f1),
+    LEPT_U64(0xdab99e59, 0x958885c4), LEPT_U64(0xe95fab36, 0x8e45eced),
+    LEPT_U64(0x88b402f7, 0xfd75539b), LEPT_U64(0x11dbcb02, 0x18ebb414),
+    LEPT_U64(0xaae103b5, 0xfcd2a881), LEPT_U64(0xd652bdc2, 0x9f26a119),
+    LEPT_U64(0xd59944a3, 0x7c0752a2), LEPT_U64(0x4be76d33, 0x46f0495f),
+    LEPT_U64(0x857fcae6, 0x2d8493a5), LEPT_U64(0x6f70a440, 0x0c562ddb),
+    LEPT_U64(0xa6dfbd9f, 0xb8e5b88e), LEPT_U64(0xcb4ccd50, 0x0f6bb952),
+    LEPT_U64(0xd097ad07, 0xa71f26b2), LEPT_U64(0x7e2000a4, 0x1346a7a7),
+    LEPT_U64(0x825ecc24, 0xc873782f), LEPT_U64(0x8ed40066, 0x8c0c28c8),
+    LEPT_U64(0xa2f67f2d, 0xfa90563b), LEPT_U64(0x72890080, 0x2f0f32fa),
+    LEPT_U64(0xcbb41ef9, 0x79346bca), LEPT_U64(0x4f2b40a0, 0x3ad2ffb9),
+    LEPT_U64(0xfea126b7, 0xd78186bc), LEPT_U64(0xe2f610c8, 0x4987bfa8),
+    LEPT_U64(0x9f24b832, 0xe6b0f436), LEPT_U64(0x0dd9ca7d, 0x2df4d7c9),
+    LEPT_U64(0xc6ede63f, 0xa05d3143), LEPT_U64(0x91503d1c, 0x79720dbb),
+    LEPT_U64(0xf8a95fcf, 0x88747d94), LEPT_U64(0x75a44c63, 0x97ce912a),
+    LEPT_U64(0x9b69dbe1, 0xb548ce7c), LEPT_U64(0xc986afbe, 0x3ee11aba),
+    LEPT_U64(0xc24452da, 0x229b021b), LEPT_U64(0xfbe85bad, 0xce996168),
+    LEPT_U64(0xf2d56790, 0xab41c2a2), LEPT_U64(0xfae27299, 0x423fb9c3),
+    LEPT_U64(0x97c560ba, 0x6b0919a5), LEPT_U64(0xdccd879f, 0xc967d41a),
+    LEPT_U64(0xbdb6b8e9, 0x05cb600f), LEPT_U64(0x5400e987, 0xbbc1c920),
+    LEPT_U64(0xed246723, 0x473e3813), LEPT_U64(0x290123e9, 0xaab23b68),
+    LEPT_U64(0x9436c076, 0x0c86e30b), LEPT_U64(0xf9a0b672, 0x0aaf6521),
+    LEPT_U64(0xb9447093, 0x8fa89bce), LEPT_U64(0xf808e40e, 0x8d5b3e69),
+    LEPT_U64(0xe7958cb8, 0x7392c2c2), LEPT_U64(0xb60b1d12, 0x30b20e04),
+    LEPT_U64(0x90bd77f3, 0x483bb9b9), LEPT_U64(0xb1c6f22b, 0x5e6f48c2),
+    LEPT_U64(0xb4ecd5f0, 0x1a4aa828), LEPT_U64(0x1e38aeb6, 0x360b1af3),
+    LEPT_U64(0xe2280b6c, 0x20dd5232), LEPT_U64(0x25c6da63, 0xc38de1b0),
+    LEPT_U64(0x8d590723, 0x948a535f), LEPT_U64(0x579c487e, 0x5a38ad0e),
+    LEPT_U64(0xb0af48ec, 0x79ace837), LEPT_U64(0x2d835a9d, 0xf0c6d851),
+    LEPT_U64(0xdcdb1b27, 0x98182244), LEPT_U64(0xf8e43145, 0x6cf88e65),
+    LEPT_U64(0x8a08f0f8, 0xbf0f156b), LEPT_U64(0x1b8e9ecb, 0x641b58ff),
+    LEPT_U64(0xac8b2d36, 0xeed2dac5), LEPT_U64(0xe272467e, 0x3d222f3f),
+    LEPT_U64(0xd7adf884, 0xaa879177), LEPT_U64(0x5b0ed81d, 0xcc6abb0f),
+    LEPT_U64(0x86ccbb52, 0xea94baea), LEPT_U64(0x98e94712, 0x9fc2b4e9),
+    LEPT_U64(0xa87fea27, 0xa539e9a5), LEPT_U64(0x3f2398d7, 0x47b36224),
+    LEPT_U64(0xd29fe4b1, 0x8e88640e), LEPT_U64(0x8eec7f0d, 0x19a03aad),
+    LEPT_U64(0x83a3eeee, 0xf9153e89), LEPT_U64(0x1953cf68, 0x300424ac),
+    LEPT_U64(0xa48ceaaa, 0xb75a8e2b), LEPT_U64(0x5fa8c342, 0x3c052dd7),
+    LEPT_U64(0xcdb02555, 0x653131b6), LEPT_U64(0x3792f412, 0xcb06794d),
+    LEPT_U64(0x808e1755, 0x5f3ebf11), LEPT_U64(0xe2bbd88b, 0xbee40bd0),
+    LEPT_U64(0xa0b19d2a, 0xb70e6ed6), LEPT_U64(0x5b6aceae, 0xae9d0ec4),
+    LEPT_U64(0xc8de0475, 0x64d20a8b), LEPT_U64(0xf245825a, 0x5a445275),
+    LEPT_U64(0xfb158592, 0xbe068d2e), LEPT_U64(0xeed6e2f0, 0xf0d56712),
+    LEPT_U64(0x9ced737b, 0xb6c4183d), LEPT_U64(0x55464dd6, 0x9685606b),
+    LEPT_U64(0xc428d05a, 0xa4751e4c), LEPT_U64(0xaa97e14c, 0x3c26b886),
+    LEPT_U64(0xf5330471, 0x4d9265df), LEPT_U64(0xd53dd99f, 0x4b3066a8),
+    LEPT_U64(0x993fe2c6, 0xd07b7fab), LEPT_U64(0xe546a803, 0x8efe4029),
+    LEPT_U64(0xbf8fdb78, 0x849a5f96), LEPT_U64(0xde985204, 0x72bdd033),
+    LEPT_U64(0xef73d256, 0xa5c0f77c), LEPT_U64(0x963e6685, 0x8f6d4440),
+    LEPT_U64(0x95a86376, 0x27989aad), LEPT_U64(0xdde70013, 0x79a44aa8),
+    LEPT_U64(0xbb127c53, 0xb17ec159), LEPT_U64(0x5560c018, 0x580d5d52),
+    LEPT_U64(0xe9d71b68, 0x9dde71af), LEPT_U64(0xaab8f01e, 0x6e10b4a6),
+    LEPT_U64(0x92267121, 0x62ab070d), LEPT_U64(0xcab39613, 0x04ca70e8),
+    LEPT_U64(0xb6b00d69, 0xbb55c8d1), LEPT_U64(0x3d607b97, 0xc5fd0d22),
+    LEPT_U64(0xe45c10c4, 0x2a2b3b05), LEPT_U64(0x8cb89a7d, 0xb77c506a),
+    LEPT_U64(0x8eb98a7a, 0x9a5b04e3), LEPT_U64(0x77f3608e, 0x92adb242),
+    LEPT_U64(0xb267ed19, 0x40f1c61c), LEPT_U64(0x55f038b2, 0x37591ed3),
+    LEPT_U64(0xdf01e85f, 0x912e37a3), LEPT_U64(0x6b6c46de, 0xc52f6688),
+    LEPT_U64(0x8b61313b, 0xbabce2c6), LEPT_U64(0x2323ac4b, 0x3b3da015),
+    LEPT_U64(0xae397d8a, 0xa96c1b77), LEPT_U64(0xabec975e, 0x0a0d081a),
+    LEPT_U64(0xd9c7dced, 0x53c72255), LEPT_U64(0x96e7bd35, 0x8c904a21),
+    LEPT_U64(0x881cea14, 0x545c7575), LEPT_U64(0x7e50d641, 0x77da2e54),
+    LEPT_U64(0xaa242499, 0x697392d2), LEPT_U64(0xdde50bd1, 0xd5d0b9e9),
+    LEPT_U64(0xd4ad2dbf, 0xc3d07787), LEPT_U64(0x955e4ec6, 0x4b44e864),
+    LEPT_U64(0x84ec3c97, 0xda624ab4), LEPT_U64(0xbd5af13b, 0xef0b113e),
+    LEPT_U64(0xa6274bbd, 0xd0fadd61), LEPT_U64(0xecb1ad8a, 0xeacdd58e),
+    LEPT_U64(0xcfb11ead, 0x453994ba), LEPT_U64(0x67de18ed, 0xa5814af2),
+    LEPT_U64(0x81ceb32c, 0x4b43fcf4), LEPT_U64(0x80eacf94, 0x8770ced7),
+    LEPT_U64(0xa2425ff7, 0x5e14fc31), LEPT_U64(0xa1258379, 0xa94d028d),
+    LEPT_U64(0xcad2f7f5, 0x359a3b3e), LEPT_U64(0x096ee458, 0x13a04330),
+    LEPT_U64(0xfd87b5f2, 0x8300ca0d), LEPT_U64(0x8bca9d6e, 0x188853fc),
+    LEPT_U64(0x9e74d1b7, 0x91e07e48), LEPT_U64(0x775ea264, 0xcf55347e),
+    LEPT_U64(0xc6120625, 0x76589dda), LEPT_U64(0x95364afe, 0x032a819e),
+    LEPT_U64(0xf79687ae, 0xd3eec551), LEPT_U64(0x3a83ddbd, 0x83f52205),
+    LEPT_U64(0x9abe14cd, 0x44753b52), LEPT_U64(0xc4926a96, 0x72793543),
+    LEPT_U64(0xc16d9a00, 0x95928a27), LEPT_U64(0x75b7053c, 0x0f178294),
+    LEPT_U64(0xf1c90080, 0xbaf72cb1), LEPT_U64(0x5324c68b, 0x12dd6339),
+    LEPT_U64(0x971da050, 0x74da7bee), LEPT_U64(0xd3f6fc16, 0xebca5e04),
+    LEPT_U64(0xbce50864, 0x92111aea), LEPT_U64(0x88f4bb1c, 0xa6bcf585),
+    LEPT_U64(0xec1e4a7d, 0xb69561a5), LEPT_U64(0x2b31e9e3, 0xd06c32e6),
+    LEPT_U64(0x9392ee8e, 0x921d5d07), LEPT_U64(0x3aff322e, 0x62439fd0),
+    LEPT_U64(0xb877aa32, 0x36a4b449), LEPT_U64(0x09befeb9, 0xfad487c3),
+    LEPT_U64(0xe69594be, 0xc44de15b), LEPT_U64(0x4c2ebe68, 0x7989a9b4),
+    LEPT_U64(0x901d7cf7, 0x3ab0acd9), LEPT_U64(0x0f9d3701, 0x4bf60a11),
+    LEPT_U64(0xb424dc35, 0x095cd80f), LEPT_U64(0x538484c1, 0x9ef38c95),
+    LEPT_U64(0xe12e1342, 0x4bb40e13), LEPT_U64(0x2865a5f2, 0x06b06fba),
+    LEPT_U64(0x8cbccc09, 0x6f5088cb), LEPT_U64(0xf93f87b7, 0x442e45d4),
+    LEPT_U64(0xafebff0b, 0xcb24aafe), LEPT_U64(0xf78f69a5, 0x1539d749),
+    LEPT_U64(0xdbe6fece, 0xbdedd5be), LEPT_U64(0xb573440e, 0x5a884d1c),
+    LEPT_U64(0x89705f41, 0x36b4a597), LEPT_U64(0x31680a88, 0xf8953031),
+    LEPT_U64(0xabcc7711, 0x8461cefc), LEPT_U64(0xfdc20d2b, 0x36ba7c3e),
+    LEPT_U64(0xd6bf94d5, 0xe57a42bc), LEPT_U64(0x3d329076, 0x04691b4d),
+    LEPT_U64(0x8637bd05, 0xaf6c69b5), LEPT_U64(0xa63f9a49, 0xc2c1b110),
+    LEPT_U64(0xa7c5ac47, 0x1b478423), LEPT_U64(0x0fcf80dc, 0x33721d54),
+    LEPT_U64(0xd1b71758, 0xe219652b), LEPT_U64(0xd3c36113, 0x404ea4a9),
+    LEPT_U64(0x83126e97, 0x8d4fdf3b), LEPT_U64(0x645a1cac, 0x083126ea),
+    LEPT_U64(0xa3d70a3d, 0x70a3d70a), LEPT_U64(0x3d70a3d7, 0x0a3d70a4),
+    LEPT_U64(0xcccccccc, 0xcccccccc), LEPT_U64(0xcccccccc, 0xcccccccd),
+    LEPT_U64(0x80000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xa0000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xc8000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xfa000000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x9c400000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xc3500000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xf4240000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x98968000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xbebc2000, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xee6b2800, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x9502f900, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xba43b740, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xe8d4a510, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x9184e72a, 0x00000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xb5e620f4, 0x80000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xe35fa931, 0xa0000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x8e1bc9bf, 0x04000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xb1a2bc2e, 0xc5000000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xde0b6b3a, 0x76400000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x8ac72304, 0x89e80000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xad78ebc5, 0xac620000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xd8d726b7, 0x177a8000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x87867832, 0x6eac9000), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xa968163f, 0x0a57b400), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xd3c21bce, 0xcceda100), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x84595161, 0x401484a0), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xa56fa5b9, 0x9019a5c8), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0xcecb8f27, 0xf4200f3a), LEPT_U64(0x00000000, 0x00000000),
+    LEPT_U64(0x813f3978, 0xf8940984), LEPT_U64(0x40000000, 0x00000000),
+    LEPT_U64(0xa18f07d7, 0x36b90be5), LEPT_U64(0x50000000, 0x00000000),
+    LEPT_U64(0xc9f2c9cd, 0x04674ede), LEPT_U64(0xa4000000, 0x00000000),
+    LEPT_U64(0xfc6f7c40, 0x45812296), LEPT_U64(0x4d000000, 0x00000000),
+    LEPT_U64(0x9dc5ada8, 0x2b70b59d), LEPT_U64(0xf0200000, 0x00000000),
+    LEPT_U64(0xc5371912, 0x364ce305), LEPT_U64(0x6c280000, 0x00000000),
+    LEPT_U64(0xf684df56, 0xc3e01bc6), LEPT_U64(0xc7320000, 0x00000000),
+    LEPT_U64(0x9a130b96, 0x3a6c115c), LEPT_U64(0x3c7f4000, 0x00000000),
+    LEPT_U64(0xc097ce7b, 0xc90715b3), LEPT_U64(0x4b9f1000, 0x00000000),
+    LEPT_U64(0xf0bdc21a, 0xbb48db20), LEPT_U64(0x1e86d400, 0x00000000),
+    LEPT_U64(0x96769950, 0xb50d88f4), LEPT_U64(0x13144480, 0x00000000),
+    LEPT_U64(0xbc143fa4, 0xe250eb31), LEPT_U64(0x17d955a0, 0x00000000),
+    LEPT_U64(0xeb194f8e, 0x1ae525fd), LEPT_U64(0x5dcfab08, 0x00000000),
+    LEPT_U64(0x92efd1b8, 0xd0cf37be), LEPT_U64(0x5aa1cae5, 0x00000000),
+    LEPT_U64(0xb7abc627, 0x050305ad), LEPT_U64(0xf14a3d9e, 0x40000000),
+    LEPT_U64(0xe596b7b0, 0xc643c719), LEPT_U64(0x6d9ccd05, 0xd0000000),
+    LEPT_U64(0x8f7e32ce, 0x7bea5c6f), LEPT_U64(0xe4820023, 0xa2000000),
+    LEPT_U64(0xb35dbf82, 0x1ae4f38b), LEPT_U64(0xdda2802c, 0x8a800000),
+    LEPT_U64(0xe0352f62, 0xa19e306e), LEPT_U64(0xd50b2037, 0xad200000),
+    LEPT_U64(0x8c213d9d, 0xa502de45), LEPT_U64(0x4526f422, 0xcc340000),
+    LEPT_U64(0xaf298d05, 0x0e4395d6), LEPT_U64(0x9670b12b, 0x7f410000),
+    LEPT_U64(0xdaf3f046, 0x51d47b4c), LEPT_U64(0x3c0cdd76, 0x5f114000),
+    LEPT_U64(0x88d8762b, 0xf324cd0f), LEPT_U64(0xa5880a69, 0xfb6ac800),
+    LEPT_U64(0xab0e93b6, 0xefee0053), LEPT_U64(0x8eea0d04, 0x7a457a00),
+    LEPT_U64(0xd5d238a4, 0xabe98068), LEPT_U64(0x72a49045, 0x98d6d880),
+    LEPT_U64(0x85a36366, 0xeb71f041), LEPT_U64(0x47a6da2b, 0x7f864750),
+    LEPT_U64(0xa70c3c40, 0xa64e6c51), LEPT_U64(0x999090b6, 0x5f67d924),
+    LEPT_U64(0xd0cf4b50, 0xcfe20765), LEPT_U64(0xfff4b4e3, 0xf741cf6d),
+    LEPT_U64(0x82818f12, 0x81ed449f), LEPT_U64(0xbff8f10e, 0x7a8921a4),
+    LEPT_U64(0xa321f2d7, 0x226895c7), LEPT_U64(0xaff72d52, 0x192b6a0d),
+    LEPT_U64(0xcbea6f8c, 0xeb02bb39), LEPT_U64(0x9bf4f8a6, 0x9f764490),
+    LEPT_U64(0xfee50b70, 0x25c36a08), LEPT_U64(0x02f236d0, 0x4753d5b4),
+    LEPT_U64(0x9f4f2726, 0x179a2245), LEPT_U64(0x01d76242, 0x2c946590),
+    LEPT_U64(0xc722f0ef, 0x9d80aad6), LEPT_U64(0x424d3ad2, 0xb7b97ef5),
+    LEPT_U64(0xf8ebad2b, 0x84e0d58b), LEPT_U64(0xd2e08987, 0x65a7deb2),
+    LEPT_U64(0x9b934c3b, 0x330c8577), LEPT_U64(0x63cc55f4, 0x9f88eb2f),
+    LEPT_U64(0xc2781f49, 0xffcfa6d5), LEPT_U64(0x3cbf6b71, 0xc76b25fb),
+    LEPT_U64(0xf316271c, 0x7fc3908a), LEPT_U64(0x8bef464e, 0x3945ef7a),
+    LEPT_U64(0x97edd871, 0xcfda3a56), LEPT_U64(0x97758bf0, 0xe3cbb5ac),
+    LEPT_U64(0xbde94e8e, 0x43d0c8ec), LEPT_U64(0x3d52eeed, 0x1cbea317),
+    LEPT_U64(0xed63a231, 0xd4c4fb27), LEPT_U64(0x4ca7aaa8, 0x63ee4bdd),
+    LEPT_U64(0x945e455f, 0x24fb1cf8), LEPT_U64(0x8fe8caa9, 0x3e74ef6a),
+    LEPT_U64(0xb975d6b6, 0xee39e436), LEPT_U64(0xb3e2fd53, 0x8e122b44),
+    LEPT_U64(0xe7d34c64, 0xa9c85d44), LEPT_U64(0x60dbbca8, 0x7196b616),
+    LEPT_U64(0x90e40fbe, 0xea1d3a4a), LEPT_U64(0xbc8955e9, 0x46fe31cd),
+    LEPT_U64(0xb51d13ae, 0xa4a488dd), LEPT_U64(0x6babab63, 0x98bdbe41),
+    LEPT_U64(0xe264589a, 0x4dcdab14), LEPT_U64(0xc696963c, 0x7eed2dd1),
+    LEPT_U64(0x8d7eb760, 0x70a08aec), LEPT_U64(0xfc1e1de5, 0xcf543ca2),
+    LEPT_U64(0xb0de6538, 0x8cc8ada8), LEPT_U64(0x3b25a55f, 0x43294bcb),
+    LEPT_U64(0xdd15fe86, 0xaffad912), LEPT_U64(0x49ef0eb7, 0x13f39ebe),
+    LEPT_U64(0x8a2dbf14, 0x2dfcc7ab), LEPT_U64(0x6e356932, 0x6c784337),
+    LEPT_U64(0xacb92ed9, 0x397bf996), LEPT_U64(0x49c2c37f, 0x07965404),
+    LEPT_U64(0xd7e77a8f, 0x87daf7fb), LEPT_U64(0xdc33745e, 0xc97be906),
+    LEPT_U64(0x86f0ac99, 0xb4e8dafd), LEPT_U64(0x69a028bb, 0x3ded71a3),
+    LEPT_U64(0xa8acd7c0, 0x222311bc), LEPT_U64(0xc40832ea, 0x0d68ce0c),
+    LEPT_U64(0xd2d80db0, 0x2aabd62b), LEPT_U64(0xf50a3fa4, 0x90c30190),
+    LEPT_U64(0x83c7088e, 0x1aab65db), LEPT_U64(0x792667c6, 0xda79e0fa),
+    LEPT_U64(0xa4b8cab1, 0xa1563f52), LEPT_U64(0x577001b8, 0x91185938),
+    LEPT_U64(0xcde6fd5e, 0x09abcf26), LEPT_U64(0xed4c0226, 0xb55e6f86),
+    LEPT_U64(0x80b05e5a, 0xc60b6178), LEPT_U64(0x544f8158, 0x315b05b4),
+    LEPT_U64(0xa0dc75f1, 0x778e39d6), LEPT_U64(0x696361ae, 0x3db1c721),
+    LEPT_U64(0xc913936d, 0xd571c84c), LEPT_U64(0x03bc3a19, 0xcd1e38e9),
+    LEPT_U64(0xfb587849, 0x4ace3a5f), LEPT_U64(0x04ab48a0, 0x4065c723),
+    LEPT_U64(0x9d174b2d, 0xcec0e47b), LEPT_U64(0x62eb0d64, 0x283f9c76),
+    LEPT_U64(0xc45d1df9, 0x42711d9a), LEPT_U64(0x3ba5d0bd, 0x324f8394),
+    LEPT_U64(0xf5746577, 0x930d6500), LEPT_U64(0xca8f44ec, 0x7ee36479),
+    LEPT_U64(0x9968bf6a, 0xbbe85f20), LEPT_U64(0x7e998b13, 0xcf4e1ecb),
+    LEPT_U64(0xbfc2ef45, 0x6ae276e8), LEPT_U64(0x9e3fedd8, 0xc321a67e),
+    LEPT_U64(0xefb3ab16, 0xc59b14a2), LEPT_U64(0xc5cfe94e, 0xf3ea101e),
+    LEPT_U64(0x95d04aee, 0x3b80ece5), LEPT_U64(0xbba1f1d1, 0x58724a12),
+    LEPT_U64(0xbb445da9, 0xca61281f), LEPT_U64(0x2a8a6e45, 0xae8edc97),
+    LEPT_U64(0xea157514, 0x3cf97226), LEPT_U64(0xf52d09d7, 0x1a3293bd),
+    LEPT_U64(0x924d692c, 0xa61be758), LEPT_U64(0x593c2626, 0x705f9c56),
+    LEPT_U64(0xb6e0c377, 0xcfa2e12e), LEPT_U64(0x6f8b2fb0, 0x0c77836c),
+    LEPT_U64(0xe498f455, 0xc38b997a), LEPT_U64(0x0b6dfb9c, 0x0f956447),
+    LEPT_U64(0x8edf98b5, 0x9a373fec), LEPT_U64(0x4724bd41, 0x89bd5eac),
+    LEPT_U64(0xb2977ee3, 0x00c50fe7), LEPT_U64(0x58edec91, 0xec2cb657),
+    LEPT_U64(0xdf3d5e9b, 0xc0f653e1), LEPT_U64(0x2f2967b6, 0x6737e3ed),
+    LEPT_U64(0x8b865b21, 0x5899f46c), LEPT_U64(0xbd79e0d2, 0x0082ee74),
+    LEPT_U64(0xae67f1e9, 0xaec07187), LEPT_U64(0xecd85906, 0x80a3aa11),
+    LEPT_U64(0xda01ee64, 0x1a708de9), LEPT_U64(0xe80e6f48, 0x20cc9495),
+    LEPT_U64(0x884134fe, 0x908658b2), LEPT_U64(0x3109058d, 0x147fdcdd),
+    LEPT_U64(0xaa51823e, 0x34a7eede), LEPT_U64(0xbd4b46f0, 0x599fd415),
+    LEPT_U64(0xd4e5e2cd, 0xc1d1ea96), LEPT_U64(0x6c9e18ac, 0x7007c91a),
+    LEPT_U64(0x850fadc0, 0x9923329e), LEPT_U64(0x03e2cf6b, 0xc604ddb0),
+    LEPT_U64(0xa6539930, 0xbf6bff45), LEPT_U64(0x84db8346, 0xb786151c),
+    LEPT_U64(0xcfe87f7c, 0xef46ff16), LEPT_U64(0xe6126418, 0x65679a63),
+    LEPT_U64(0x81f14fae, 0x158c5f6e), LEPT_U64(0x4fcb7e8f, 0x3f60c07e),
+    LEPT_U64(0xa26da399, 0x9aef7749), LEPT_U64(0xe3be5e33, 0x0f38f09d),
+    LEPT_U64(0xcb090c80, 0x01ab551c), LEPT_U64(0x5cadf5bf, 0xd3072cc5),
+    LEPT_U64(0xfdcb4fa0, 0x02162a63), LEPT_U64(0x73d9732f, 0xc7c8f7f6),
+    LEPT_U64(0x9e9f11c4, 0x014dda7e), LEPT_U64(0x2867e7fd, 0xdcdd9afa),
+    LEPT_U64(0xc646d635, 0x01a1511d), LEPT_U64(0xb281e1fd, 0x541501b8),
+    LEPT_U64(0xf7d88bc2, 0x4209a565), LEPT_U64(0x1f225a7c, 0xa91a4226),
+    LEPT_U64(0x9ae75759, 0x6946075f), LEPT_U64(0x3375788d, 0xe9b06958),
+    LEPT_U64(0xc1a12d2f, 0xc3978937), LEPT_U64(0x0052d6b1, 0x641c83ae),
+    LEPT_U64(0xf209787b, 0xb47d6b84), LEPT_U64(0xc0678c5d, 0xbd23a49a),
+    LEPT_U64(0x9745eb4d, 0x50ce6332), LEPT_U64(0xf840b7ba, 0x963646e0),
+    LEPT_U64(0xbd176620, 0xa501fbff), LEPT_U64(0xb650e5a9, 0x3bc3d898),
+    LEPT_U64(0xec5d3fa8, 0xce427aff), LEPT_U64(0xa3e51f13, 0x8ab4cebe),
+    LEPT_U64(0x93ba47c9, 0x80e98cdf), LEPT_U64(0xc66f336c, 0x36b10137),
+    LEPT_U64(0xb8a8d9bb, 0xe123f017), LEPT_U64(0xb80b0047, 0x445d4184),
+    LEPT_U64(0xe6d3102a, 0xd96cec1d), LEPT_U64(0xa60dc059, 0x157491e5),
+    LEPT_U64(0x9043ea1a, 0xc7e41392), LEPT_U64(0x87c89837, 0xad68db2f),
+    LEPT_U64(0xb454e4a1, 0x79dd1877), LEPT_U64(0x29babe45, 0x98c311fb),
+    LEPT_U64(0xe16a1dc9, 0xd8545e94), LEPT_U64(0xf4296dd6, 0xfef3d67a),
+    LEPT_U64(0x8ce2529e, 0x2734bb1d), LEPT_U64(0x1899e4a6, 0x5f58660c),
+    LEPT_U64(0xb01ae745, 0xb101e9e4), LEPT_U64(0x5ec05dcf, 0xf72e7f8f),
+    LEPT_U64(0xdc21a117, 0x1d42645d), LEPT_U64(0x76707543, 0xf4fa1f73),
+    LEPT_U64(0x899504ae, 0x72497eba), LEPT_U64(0x6a06494a, 0x791c53a8),
+    LEPT_U64(0xabfa45da, 0x0edbde69), LEPT_U64(0x0487db9d, 0x17636892),
+    LEPT_U64(0xd6f8d750, 0x9292d603), LEPT_U64(0x45a9d284, 0x5d3c42b6),
+    LEPT_U64(0x865b8692, 0x5b9bc5c2), LEPT_U64(0x0b8a2392, 0xba45a9b2),
+    LEPT_U64(0xa7f26836, 0xf282b732), LEPT_U64(0x8e6cac77, 0x68d7141e),
+    LEPT_U64(0xd1ef0244, 0xaf2364ff), LEPT_U64(0x3207d795, 0x430cd926),
+    LEPT_U64(0x8335616a, 0xed761f1f), LEPT_U64(0x7f44e6bd, 0x49e807b8),
+    LEPT_U64(0xa402b9c5, 0xa8d3a6e7), LEPT_U64(0x5f16206c, 0x9c6209a6),
+    LEPT_U64(0xcd036837, 0x130890a1), LEPT_U64(0x36dba887, 0xc37a8c0f),
+    LEPT_U64(0x80222122, 0x6be55a64), LEPT_U64(0xc2494954, 0xda2c9789),
+    LEPT_U64(0xa02aa96b, 0x06deb0fd), LEPT_U64(0xf2db9baa, 0x10b7bd6c),
+    LEPT_U64(0xc83553c5, 0xc8965d3d), LEPT_U64(0x6f928294, 0x94e5acc7),
+    LEPT_U64(0xfa42a8b7, 0x3abbf48c), LEPT_U64(0xcb772339, 0xba1f17f9),
+    LEPT_U64(0x9c69a972, 0x84b578d7), LEPT_U64(0xff2a7604, 0x14536efb),
+    LEPT_U64(0xc38413cf, 0x25e2d70d), LEPT_U64(0xfef51385, 0x19684aba),
+    LEPT_U64(0xf46518c2, 0xef5b8cd1), LEPT_U64(0x7eb25866, 0x5fc25d69),
+    LEPT_U64(0x98bf2f79, 0xd5993802), LEPT_U64(0xef2f773f, 0xfbd97a61),
+    LEPT_U64(0xbeeefb58, 0x4aff8603), LEPT_U64(0xaafb550f, 0xfacfd8fa),
+    LEPT_U64(0xeeaaba2e, 0x5dbf6784), LEPT_U64(0x95ba2a53, 0xf983cf38),
+    LEPT_U64(0x952ab45c, 0xfa97a0b2), LEPT_U64(0xdd945a74, 0x7bf26183),
+    LEPT_U64(0xba756174, 0x393d88df), LEPT_U64(0x94f97111, 0x9aeef9e4),
+    LEPT_U64(0xe912b9d1, 0x478ceb17), LEPT_U64(0x7a37cd56, 0x01aab85d),
+    LEPT_U64(0x91abb422, 0xccb812ee), LEPT_U64(0xac62e055, 0xc10ab33a),
+    LEPT_U64(0xb616a12b, 0x7fe617aa), LEPT_U64(0x577b986b, 0x314d6009),
+    LEPT_U64(0xe39c4976, 0x5fdf9d94), LEPT_U64(0xed5a7e85, 0xfda0b80b),
+    LEPT_U64(0x8e41ade9, 0xfbebc27d), LEPT_U64(0x14588f13, 0xbe847307),
+    LEPT_U64(0xb1d21964, 0x7ae6b31c), LEPT_U64(0x596eb2d8, 0xae258fc8),
+    LEPT_U64(0xde469fbd, 0x99a05fe3), LEPT_U64(0x6fca5f8e, 0xd9aef3bb),
+    LEPT_U64(0x8aec23d6, 0x80043bee), LEPT_U64(0x25de7bb9, 0x480d5854),
+    LEPT_U64(0xada72ccc, 0x20054ae9), LEPT_U64(0xaf561aa7, 0x9a10ae6a),
+    LEPT_U64(0xd910f7ff, 0x28069da4), LEPT_U64(0x1b2ba151, 0x8094da04),
+    LEPT_U64(0x87aa9aff, 0x79042286), LEPT_U64(0x90fb44d2, 0xf05d0842),
+    LEPT_U64(0xa99541bf, 0x57452b28), LEPT_U64(0x353a1607, 0xac744a53),
+    LEPT_U64(0xd3fa922f, 0x2d1675f2), LEPT_U64(0x42889b89, 0x97915ce8),
+    LEPT_U64(0x847c9b5d, 0x7c2e09b7), LEPT_U64(0x69956135, 0xfebada11),
+    LEPT_U64(0xa59bc234, 0xdb398c25), LEPT_U64(0x43fab983, 0x7e699095),
+    LEPT_U64(0xcf02b2c2, 0x1207ef2e), LEPT_U64(0x94f967e4, 0x5e03f4bb),
+    LEPT_U64(0x8161afb9, 0x4b44f57d), LEPT_U64(0x1d1be0ee, 0xbac278f5),
+    LEPT_U64(0xa1ba1ba7, 0x9e1632dc), LEPT_U64(0x6462d92a, 0x69731732),
+    LEPT_U64(0xca28a291, 0x859bbf93), LEPT_U64(0x7d7b8f75, 0x03cfdcfe),
+    LEPT_U64(0xfcb2cb35, 0xe702af78), LEPT_U64(0x5cda7352, 0x44c3d43e),
+    LEPT_U64(0x9defbf01, 0xb061adab), LEPT_U64(0x3a088813, 0x6afa64a7),
+    LEPT_U64(0xc56baec2, 0x1c7a1916), LEPT_U64(0x088aaa18, 0x45b8fdd0),
+    LEPT_U64(0xf6c69a72, 0xa3989f5b), LEPT_U64(0x8aad549e, 0x57273d45),
+    LEPT_U64(0x9a3c2087, 0xa63f6399), LEPT_U64(0x36ac54e2, 0xf678864b),
+    LEPT_U64(0xc0cb28a9, 0x8fcf3c7f), LEPT_U64(0x84576a1b, 0xb416a7dd),
+    LEPT_U64(0xf0fdf2d3, 0xf3c30b9f), LEPT_U64(0x656d44a2, 0xa11c51d5),
+    LEPT_U64(0x969eb7c4, 0x7859e743), LEPT_U64(0x9f644ae5, 0xa4b1b325),
+    LEPT_U64(0xbc4665b5, 0x96706114), LEPT_U64(0x873d5d9f, 0x0dde1fee),
+    LEPT_U64(0xeb57ff22, 0xfc0c7959), LEPT_U64(0xa90cb506, 0xd155a7ea),
+    LEPT_U64(0x9316ff75, 0xdd87cbd8), LEPT_U64(0x09a7f124, 0x42d588f2),
+    LEPT_U64(0xb7dcbf53, 0x54e9bece), LEPT_U64(0x0c11ed6d, 0x538aeb2f),
+    LEPT_U64(0xe5d3ef28, 0x2a242e81), LEPT_U64(0x8f1668c8, 0xa86da5fa),
+    LEPT_U64(0x8fa47579, 0x1a569d10), LEPT_U64(0xf96e017d, 0x694487bc),
+    LEPT_U64(0xb38d92d7, 0x60ec4455), LEPT_U64(0x37c981dc, 0xc395a9ac),
+    LEPT_U64(0xe070f78d, 0x3927556a), LEPT_U64(0x85bbe253, 0xf47b1417),
+    LEPT_U64(0x8c469ab8, 0x43b89562), LEPT_U64(0x93956d74, 0x78ccec8e),
+    LEPT_U64(0xaf584166, 0x54a6babb), LEPT_U64(0x387ac8d1, 0x970027b2),
+    LEPT_U64(0xdb2e51bf, 0xe9d0696a), LEPT_U64(0x06997b05, 0xfcc0319e),
+    LEPT_U64(0x88fcf317, 0xf22241e2), LEPT_U64(0x441fece3, 0xbdf81f03),
+    LEPT_U64(0xab3c2fdd, 0xeeaad25a), LEPT_U64(0xd527e81c, 0xad7626c3),
+    LEPT_U64(0xd60b3bd5, 0x6a5586f1), LEPT_U64(0x8a71e223, 0xd8d3b074),
+    LEPT_U64(0x85c70565, 0x62757456), LEPT_U64(0xf6872d56, 0x67844e49),
+    LEPT_U64(0xa738c6be, 0xbb12d16c), LEPT_U64(0xb428f8ac, 0x016561db),
+    LEPT_U64(0xd106f86e, 0x69d785c7), LEPT_U64(0xe13336d7, 0x01beba52),
+    LEPT_U64(0x82a45b45, 0x0226b39c), LEPT_U64(0xecc00246, 0x61173473),
+    LEPT_U64(0xa34d7216, 0x42b06084), LEPT_U64(0x27f002d7, 0xf95d0190),
+    LEPT_U64(0xcc20ce9b, 0xd35c78a5), LEPT_U64(0x31ec038d, 0xf7b441f4),
+    LEPT_U64(0xff290242, 0xc83396ce), LEPT_U64(0x7e670471, 0x75a15271),
+    LEPT_U64(0x9f79a169, 0xbd203e41), LEPT_U64(0x0f0062c6, 0xe984d386),
+    LEPT_U64(0xc75809c4, 0x2c684dd1), LEPT_U64(0x52c07b78, 0xa3e60868),
+    LEPT_U64(0xf92e0c35, 0x37826145), LEPT_U64(0xa7709a56, 0xccdf8a82),
+    LEPT_U64(0x9bbcc7a1, 0x42b17ccb), LEPT_U64(0x88a66076, 0x400bb691),
+    LEPT_U64(0xc2abf989, 0x935ddbfe), LEPT_U64(0x6acff893, 0xd00ea435),
+    LEPT_U64(0xf356f7eb, 0xf83552fe), LEPT_U64(0x0583f6b8, 0xc4124d43),
+    LEPT_U64(0x98165af3, 0x7b2153de), LEPT_U64(0xc3727a33, 0x7a8b704a),
+    LEPT_U64(0xbe1bf1b0, 0x59e9a8d6), LEPT_U64(0x744f18c0, 0x592e4c5c),
+    LEPT_U64(0xeda2ee1c, 0x7064130c), LEPT_U64(0x1162def0, 0x6f79df73),
+    LEPT_U64(0x9485d4d1, 0xc63e8be7), LEPT_U64(0x8addcb56, 0x45ac2ba8),
+    LEPT_U64(0xb9a74a06, 0x37ce2ee1), LEPT_U64(0x6d953e2b, 0xd7173692),
+    LEPT_U64(0xe8111c87, 0xc5c1ba99), LEPT_U64(0xc8fa8db6, 0xccdd0437),
+    LEPT_U64(0x910ab1d4, 0xdb9914a0), LEPT_U64(0x1d9c9892, 0x400a22a2),
+    LEPT_U64(0xb54d5e4a, 0x127f59c8), LEPT_U64(0x2503beb6, 0xd00cab4b),
+    LEPT_U64(0xe2a0b5dc, 0x971f303a), LEPT_U64(0x2e44ae64, 0x840fd61d),
+    LEPT_U64(0x8da471a9, 0xde737e24), LEPT_U64(0x5ceaecfe, 0xd289e5d2),
+    LEPT_U64(0xb10d8e14, 0x56105dad), LEPT_U64(0x7425a83e, 0x872c5f47),
+    LEPT_U64(0xdd50f199, 0x6b947518), LEPT_U64(0xd12f124e, 0x28f77719),
+    LEPT_U64(0x8a5296ff, 0xe33cc92f), LEPT_U64(0x82bd6b70, 0xd99aaa6f),
+    LEPT_U64(0xace73cbf, 0xdc0bfb7b), LEPT_U64(0x636cc64d, 0x1001550b),
+    LEPT_U64(0xd8210bef, 0xd30efa5a), LEPT_U64(0x3c47f7e0, 0x5401aa4e),
+    LEPT_U64(0x8714a775, 0xe3e95c78), LEPT_U64(0x65acfaec, 0x34810a71),
+    LEPT_U64(0xa8d9d153, 0x5ce3b396), LEPT_U64(0x7f1839a7, 0x41a14d0d),
+    LEPT_U64(0xd31045a8, 0x341ca07c), LEPT_U64(0x1ede4811, 0x1209a050),
+    LEPT_U64(0x83ea2b89, 0x2091e44d), LEPT_U64(0x934aed0a, 0xab460432),
+    LEPT_U64(0xa4e4b66b, 0x68b65d60), LEPT_U64(0xf81da84d, 0x5617853f),
+    LEPT_U64(0xce1de406, 0x42e3f4b9), LEPT_U64(0x36251260, 0xab9d668e),
+    LEPT_U64(0x80d2ae83, 0xe9ce78f3), LEPT_U64(0xc1d72b7c, 0x6b426019),
+    LEPT_U64(0xa1075a24, 0xe4421730), LEPT_U64(0xb24cf65b, 0x8612f81f),
+    LEPT_U64(0xc94930ae, 0x1d529cfc), LEPT_U64(0xdee033f2, 0x6797b627),
+    LEPT_U64(0xfb9b7cd9, 0xa4a7443c), LEPT_U64(0x169840ef, 0x017da3b1),
+    LEPT_U64(0x9d412e08, 0x06e88aa5), LEPT_U64(0x8e1f2895, 0x60ee864e),
+    LEPT_U64(0xc491798a, 0x08a2ad4e), LEPT_U64(0xf1a6f2ba, 0xb92a27e2),
+    LEPT_U64(0xf5b5d7ec, 0x8acb58a2), LEPT_U64(0xae10af69, 0x6774b1db),
+    LEPT_U64(0x9991a6f3, 0xd6bf1765), LEPT_U64(0xacca6da1, 0xe0a8ef29),
+    LEPT_U64(0xbff610b0, 0xcc6edd3f), LEPT_U64(0x17fd090a, 0x58d32af3),
+    LEPT_U64(0xeff394dc, 0xff8a948e), LEPT_U64(0xddfc4b4c, 0xef07f5b0),
+    LEPT_U64(0x95f83d0a, 0x1fb69cd9), LEPT_U64(0x4abdaf10, 0x1564f98e),
+    LEPT_U64(0xbb764c4c, 0xa7a4440f), LEPT_U64(0x9d6d1ad4, 0x1abe37f1),
+    LEPT_U64(0xea53df5f, 0xd18d5513), LEPT_U64(0x84c86189, 0x216dc5ed),
+    LEPT_U64(0x92746b9b, 0xe2f8552c), LEPT_U64(0x32fd3cf5, 0xb4e49bb4),
+    LEPT_U64(0xb7118682, 0xdbb66a77), LEPT_U64(0x3fbc8c33, 0x221dc2a1),
+    LEPT_U64(0xe4d5e823, 0x92a40515), LEPT_U64(0x0fabaf3f, 0xeaa5334a),
+    LEPT_U64(0x8f05b116, 0x3ba6832d), LEPT_U64(0x29cb4d87, 0xf2a7400e),
+    LEPT_U64(0xb2c71d5b, 0xca9023f8), LEPT_U64(0x743e20e9, 0xef511012),
+    LEPT_U64(0xdf78e4b2, 0xbd342cf6), LEPT_U64(0x914da924, 0x6b255416),
+    LEPT_U64(0x8bab8eef, 0xb6409c1a), LEPT_U64(0x1ad089b6, 0xc2f7548e),
+    LEPT_U64(0xae9672ab, 0xa3d0c320), LEPT_U64(0xa184ac24, 0x73b529b1),
+    LEPT_U64(0xda3c0f56, 0x8cc4f3e8), LEPT_U64(0xc9e5d72d, 0x90a2741e),
+    LEPT_U64(0x88658996, 0x17fb1871), LEPT_U64(0x7e2fa67c, 0x7a658892),
+    LEPT_U64(0xaa7eebfb, 0x9df9de8d), LEPT_U64(0xddbb901b, 0x98feeab7),
+    LEPT_U64(0xd51ea6fa, 0x85785631), LEPT_U64(0x552a7422, 0x7f3ea565),
+    LEPT_U64(0x8533285c, 0x936b35de), LEPT_U64(0xd53a8895, 0x8f87275f),
+    LEPT_U64(0xa67ff273, 0xb8460356), LEPT_U64(0x8a892aba, 0xf368f137),
+    LEPT_U64(0xd01fef10, 0xa657842c), LEPT_U64(0x2d2b7569, 0xb0432d85),
+    LEPT_U64(0x8213f56a, 0x67f6b29b), LEPT_U64(0x9c3b2962, 0x0e29fc73),
+    LEPT_U64(0xa298f2c5, 0x01f45f42), LEPT_U64(0x8349f3ba, 0x91b47b8f),
+    LEPT_U64(0xcb3f2f76, 0x42717713), LEPT_U64(0x241c70a9, 0x36219a73),
+    LEPT_U64(0xfe0efb53, 0xd30dd4d7), LEPT_U64(0xed238cd3, 0x83aa0110),
+    LEPT_U64(0x9ec95d14, 0x63e8a506), LEPT_U64(0xf4363804, 0x324a40aa),
+    LEPT_U64(0xc67bb459, 0x7ce2ce48), LEPT_U64(0xb143c605, 0x3edcd0d5),
+    LEPT_U64(0xf81aa16f, 0xdc1b81da), LEPT_U64(0xdd94b786, 0x8e94050a),
+    LEPT_U64(0x9b10a4e5, 0xe9913128), LEPT_U64(0xca7cf2b4, 0x191c8326),
+    LEPT_U64(0xc1d4ce1f, 0x63f57d72), LEPT_U64(0xfd1c2f61, 0x1f63a3f0),
+    LEPT_U64(0xf24a01a7, 0x3cf2dccf), LEPT_U64(0xbc633b39, 0x673c8cec),
+    LEPT_U64(0x976e4108, 0x8617ca01), LEPT_U64(0xd5be0503, 0xe085d813),
+    LEPT_U64(0xbd49d14a, 0xa79dbc82), LEPT_U64(0x4b2d8644, 0xd8a74e18),
+    LEPT_U64(0xec9c459d, 0x51852ba2), LEPT_U64(0xddf8e7d6, 0x0ed1219e),
+    LEPT_U64(0x93e1ab82, 0x52f33b45), LEPT_U64(0xcabb90e5, 0xc942b503),
+    LEPT_U64(0xb8da1662, 0xe7b00a17), LEPT_U64(0x3d6a751f, 0x3b936243),
+    LEPT_U64(0xe7109bfb, 0xa19c0c9d), LEPT_U64(0x0cc51267, 0x0a783ad4),
+    LEPT_U64(0x906a617d, 0x450187e2), LEPT_U64(0x27fb2b80, 0x668b24c5),
+    LEPT_U64(0xb484f9dc, 0x9641e9da), LEPT_U64(0xb1f9f660, 0x802dedf6),
+    LEPT_U64(0xe1a63853, 0xbbd26451), LEPT_U64(0x5e7873f8, 0xa0396973),
+    LEPT_U64(0x8d07e334, 0x55637eb2), LEPT_U64(0xdb0b487b, 0x6423e1e8),
+    LEPT_U64(0xb049dc01, 0x6abc5e5f), LEPT_U64(0x91ce1a9a, 0x3d2cda62),
+    LEPT_U64(0xdc5c5301, 0xc56b75f7), LEPT_U64(0x7641a140, 0xcc7810fb),
+    LEPT_U64(0x89b9b3e1, 0x1b6329ba), LEPT_U64(0xa9e904c8, 0x7fcb0a9d),
+    LEPT_U64(0xac2820d9, 0x623bf429), LEPT_U64(0x546345fa, 0x9fbdcd44),
+    LEPT_U64(0xd732290f, 0xbacaf133), LEPT_U64(0xa97c1779, 0x47ad4095),
+    LEPT_U64(0x867f59a9, 0xd4bed6c0), LEPT_U64(0x49ed8eab, 0xcccc485d),
+    LEPT_U64(0xa81f3014, 0x49ee8c70), LEPT_U64(0x5c68f256, 0xbfff5a74),
+    LEPT_U64(0xd226fc19, 0x5c6a2f8c), LEPT_U64(0x73832eec, 0x6fff3111),
+    LEPT_U64(0x83585d8f, 0xd9c25db7), LEPT_U64(0xc831fd53, 0xc5ff7eab),
+    LEPT_U64(0xa42e74f3, 0xd032f525), LEPT_U64(0xba3e7ca8, 0xb77f5e55),
+    LEPT_U64(0xcd3a1230, 0xc43fb26f), LEPT_U64(0x28ce1bd2, 0xe55f35eb),
+    LEPT_U64(0x80444b5e, 0x7aa7cf85), LEPT_U64(0x7980d163, 0xcf5b81b3),
+    LEPT_U64(0xa0555e36, 0x1951c366), LEPT_U64(0xd7e105bc, 0xc332621f),
+    LEPT_U64(0xc86ab5c3, 0x9fa63440), LEPT_U64(0x8dd9472b, 0xf3fefaa7),
+    LEPT_U64(0xfa856334, 0x878fc150), LEPT_U64(0xb14f98f6, 0xf0feb951),
+    LEPT_U64(0x9c935e00, 0xd4b9d8d2), LEPT_U64(0x6ed1bf9a, 0x569f33d3),
+    LEPT_U64(0xc3b83581, 0x09e84f07), LEPT_U64(0x0a862f80, 0xec4700c8),
+    LEPT_U64(0xf4a642e1, 0x4c6262c8), LEPT_U64(0xcd27bb61, 0x2758c0fa),
+    LEPT_U64(0x98e7e9cc, 0xcfbd7dbd), LEPT_U64(0x8038d51c, 0xb897789c),
+    LEPT_U64(0xbf21e440, 0x03acdd2c), LEPT_U64(0xe0470a63, 0xe6bd56c3),
+    LEPT_U64(0xeeea5d50, 0x04981478), LEPT_U64(0x1858ccfc, 0xe06cac74),
+    LEPT_U64(0x95527a52, 0x02df0ccb), LEPT_U64(0x0f37801e, 0x0c43ebc8),
+    LEPT_U64(0xbaa718e6, 0x8396cffd), LEPT_U64(0xd3056025, 0x8f54e6ba),
+    LEPT_U64(0xe950df20, 0x247c83fd), LEPT_U64(0x47c6b82e, 0xf32a2069),
+    LEPT_U64(0x91d28b74, 0x16cdd27e), LEPT_U64(0x4cdc331d, 0x57fa5441),
+    LEPT_U64(0xb6472e51, 0x1c81471d), LEPT_U64(0xe0133fe4, 0xadf8e952),
+    LEPT_U64(0xe3d8f9e5, 0x63a198e5), LEPT_U64(0x58180fdd, 0xd97723a6),
+    LEPT_U64(0x8e679c2f, 0x5e44ff8f), LEPT_U64(0x570f09ea, 0xa7ea7648)
+};
+
+static lept_uint64 lept_umul128(lept_uint64 a, lept_uint64 b, lept_uint64* hi) {
+#if defined(__GNUC__) && defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 r = (unsigned __int128)a * b;
+    *hi = (lept_uint64)(r >> 64);
+    return (lept_uint64)r;
+#else
+    lept_uint64 al = a & 0xFFFFFFFFu, ah = a >> 32;
+    lept_uint64 bl = b & 0xFFFFFFFFu, bh = b >> 32;
+    lept_uint64 ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    lept_uint64 mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
+static int lept_clz64(lept_uint64 x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & LEPT_U64(0x80000000, 0))) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*
+ * Eisel-Lemire: w * 10^q as IEEE-754 binary64 bits (without sign), w != 0.
+ * Returns 0x7FF0000000000000 (infinity) on overflow.
+ */
+static lept_uint64 lept_eisel_lemire(lept_uint64 w, long q) {
+    const lept_uint64* pow5;
+    lept_uint64 lo, hi, lo2, hi2, mantissa;
+    int lz, upperbit, shift;
+    long power2;
+
+    if (q < LEPT_POW5_MIN_EXP) {
+        return 0;
+    }
+    if (q > LEPT_POW5_MAX_EXP) {
+        return LEPT_U64(0x7FF00000, 0);
+    }
+    lz = lept_clz64(w);
+    w <<= lz;
+    pow5 = &lept_pow5_128[2 * (q - LEPT_POW5_MIN_EXP)];
+    lo = lept_umul128(w, pow5[0], &hi);
+    /* the low bits that decide rounding may be off: refine with the second word */
+    if ((hi & 0x1FF) == 0x1FF) {
+        lo2 = lept_umul128(w, pow5[1], &hi2);
+        lo += hi2;
+        if (hi2 > lo) {
+            hi++;
+        }
+        (void)lo2;
+    }
+    upperbit = (int)(hi >> 63);
+    shift = upperbit + 64 - 52 - 3;
+    mantissa = hi >> shift;
+    /* floor(log2(10^q)) + 63, without floating point */
+    power2 = (((152170L + 65536L) * q) >> 16) + 63 + upperbit - lz + 1023;
+    if (power2 <= 0) {
+        /* subnormal */
+        if (-power2 + 1 >= 64) {
+            return 0;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < LEPT_U64(0x00100000, 0)) ? 0 : 1;
+        return ((lept_uint64)power2 << 52) | (mantissa & LEPT_U64(0x000FFFFF, 0xFFFFFFFF));
+    }
+    /* exactly halfway between two doubles: round to even instead of up */
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi) {
+        mantissa &= ~(lept_uint64)1;
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= LEPT_U64(0x00200000, 0)) {
+        mantissa = LEPT_U64(0x00100000, 0);
+        power2++;
+    }
+    mantissa &= LEPT_U64(0x000FFFFF, 0xFFFFFFFF);
+    if (power2 >= 0x7FF) {
+        return LEPT_U64(0x7FF00000, 0);
+    }
+    return ((lept_uint64)power2 << 52) | mantissa;
+}
+
+/* the x87 FPU rounds twice (80-bit then 64-bit), which breaks the fast path */
+#if defined(__i386__) && !defined(__SSE2_MATH__)
+#define LEPT_NO_CLINGER 1
+#endif
+
+/* w * 10^q, rounded to nearest. Returns 0 if only a slow path can decide. */
+static int lept_decimal_to_double(lept_uint64 w, long q, int truncated, double* d) {
+    static const double pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    lept_uint64 bits;
+    if (w == 0) {
+        *d = 0.0;
+        return 1;
+    }
+#ifndef LEPT_NO_CLINGER
+    if (!truncated && q >= -22 && q <= 22 && w <= LEPT_U64(0x00200000, 0)) {
+        *d = (double)w;
+        *d = (q < 0) ? *d / pow10[-q] : *d * pow10[q];
+        return 1;
+    }
+#endif
+    bits = lept_eisel_lemire(w, q);
+    /* digits were dropped: the value lies in [w, w+1) * 10^q, both ends must agree */
+    if (truncated && (w + 1 == 0 || lept_eisel_lemire(w + 1, q) != bits)) {
+        return 0;
+    }
+    assert(sizeof(double) == sizeof(bits));
+    memcpy(d, &bits, sizeof(double));
+    return 1;
+}
+
+static int lept_parse_number(lept_context* c, lept_value* v) {
+    const char* p = c->json;
+    lept_uint64 w = 0;
+    long q = 0, e = 0;
+    int neg = 0, eneg = 0, digits = 0, truncated = 0;
+    double d;
+
+    if (PEEK(c, p) == '-') {
+        neg = 1; p++;
+    }
+    /* integer part: at most 19 significant digits fit in w, the rest scale q */
+    if (PEEK(c, p) == '0') {
+        p++;
+    }else if (IS_DIGIT_1_9(PEEK(c, p))) {
+        for (; IS_DIGIT(PEEK(c, p)); p++) {
+            if (digits < 19) {
+                w = w * 10 + (unsigned)(*p - '0');
+                digits++;
+            }else {
+                q++;
+                truncated |= (*p != '0');
+            }
+        }
+    }else {
+        return LEPT_PARSE_INVALID_VALUE;
+    }
+    if (PEEK(c, p) != '.' && PEEK(c, p) != 'e' && PEEK(c, p) != 'E') {
+        /* integral literal: keep it exact if it fits in 64 bits, "-0" stays a double */
+        if (q == 1 && (w < LEPT_U64(0x19999999, 0x99999999) ||
+                      (w == LEPT_U64(0x19999999, 0x99999999) && p[-1] <= '5'))) {
+            w = w * 10 + (unsigned)(p[-1] - '0');
+            q = 0;
+        }
+        if (q == 0 && !(neg && w == 0) && (!neg || w <= LEPT_INT64_MAX + 1)) {
+            if (neg) {
+                lept_set_int64(v, -(lept_int64)(w - 1) - 1);
+            }else {
+                lept_set_uint64(v, w);
+            }
+            c->json = p;
+            return LEPT_PARSE_OK;
+        }
+    }
+    /* fraction */
+    if (PEEK(c, p) == '.') {
+        p++;
+        if (!IS_DIGIT(PEEK(c, p))) {
+            return LEPT_PARSE_INVALID_VALUE;
+        }
+        for (; IS_DIGIT(PEEK(c, p)); p++) {
+            if (digits < 19) {
+                w = w * 10 + (unsigned)(*p - '0');
+                q--;
+                if (w != 0) {
+                    digits++;   /* leading zeros are not significant */
+                }
+            }else {
+                truncated |= (*p != '0');
+            }
+        }
+    }
+    /* exponent */
+    if (PEEK(c, p) == 'e' || PEEK(c, p) == 'E') {
+        p++;
+        if (PEEK(c, p) == '+' || PEEK(c, p) == '-') {
+            eneg = (*p++ == '-');
+        }
+        if (!IS_DIGIT(PEEK(c, p))) {
+            return LEPT_PARSE_INVALID_VALUE;
+        }
+        for (; IS_DIGIT(PEEK(c, p)); p++) {
+            if (e < 100000) {
+                e = e * 10 + (*p - '0');
+            }
+        }
+        q += eneg ? -e : e;
+    }
+
+    /*
+     * lazy: keep the literal unless it might overflow. w has `digits` digits,
+     * so the value is below 10^(q + digits); only the 10^308 decade needs a
+     * conversion to tell.
+     */
+    if ((c->flags & LEPT_PARSE_FLAG_LAZY_NUMBER) && (w == 0 || q + digits - 1 < 308)) {
+        v->u.r.p = c->json;
+        v->u.r.len = (size_t)(p - c->json);
+        v->type = LEPT_NUMBER;
+        v->flags = LEPT_VALUE_RAW;
+        c->json = p;
+        return LEPT_PARSE_OK;
+    }
+    if (lept_decimal_to_double(w, q, truncated, &d)) {
+        if (d > DBL_MAX) {
+            return LEPT_PARSE_NUMBER_TOO_BIG;
+        }
+        v->u.n = neg ? -d : d;
+    }else {
+        /*
+         * slow path: strtod() needs the literal '\0'-terminated, and its '.'
+         * as the decimal point of the current locale
+         */
+        const char* s = c->json;
+        char point = *localeconv()->decimal_point;
+        if (c->end != NULL || point != '.') {
+            size_t i, len = (size_t)(p - c->json);
+            char* t;
+            PUTS(c, c->json, len);
+            PUTC(c, '\0');
+            t = (char*) lept_context_pop(c, len + 1);
+            for (i = 0; i < len; i++) {
+                if (t[i] == '.') {
+                    t[i] = point;
+                }
+            }
+            s = t;
+        }
+        errno = 0;
+        v->u.n = strtod(s, NULL);
+        if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n ==-HUGE_VAL)) {
+            return LEPT_PARSE_NUMBER_TOO_BIG;
+        }
+    }
+    v->type = LEPT_NUMBER;
+    c->json = p;
+    return LEPT_PARSE_OK;
+}
+
+/* value of each hex digit, 255 for any other byte */
+static const unsigned char lept_hex_value[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9, 255, 255, 255, 255, 255, 255,
+    255,  10,  11,  12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255,  10,  11,  12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+static const char* lept_parse_hex4(const char* p, unsigned int* u) {
+    const unsigned char* s = (const unsigned char*)p;
+    unsigned int d0, d1, d2, d3;
+    /* stops at the first byte that is not a digit, so never reads past a '\0' */
+    if ((d0 = lept_hex_value[s[0]]) > 15 || (d1 = lept_hex_value[s[1]]) > 15 ||
+        (d2 = lept_hex_value[s[2]]) > 15 || (d3 = lept_hex_value[s[3]]) > 15) {
+        return NULL;
+    }
+    *u = (d0 << 12) | (d1 << 8) | (d2 << 4) | d3;
+    return p + 4;
+}
+static size_t lept_encode_utf8(char* buf, unsigned int u) {
+    if (u <= 0x007F) {
+        buf[0] = (char)(u & 0xFF);
+        return 1;
+    }else if (u <= 0x07FF ) {
+        buf[0] = (char)(0xC0 | ( (u >>  6) & 0x1F ) );
+        buf[1] = (char)(0x80 | (  u        & 0X3F ) );
+        return 2;
+    }else if (u <= 0xFFFF ) {
+        buf[0] = (char)(0xE0 | ( (u >> 12) & 0x0F ) );
+        buf[1] = (char)(0x80 | ( (u >>  6) & 0x3F ) );
+        buf[2] = (char)(0x80 | ( (u      ) & 0x3F ) );
+        return 3;
+    }else {
+        assert( u <= 0x10FFFF );
+        buf[0] = (char)(0xF0 | ( (u >> 18) & 0x07 ) );
+        buf[1] = (char)(0x80 | ( (u >> 12) & 0x3F ) );
+        buf[2] = (char)(0x80 | ( (u >>  6) & 0x3F ) );
+        buf[3] = (char)(0x80 | ( (u      ) & 0x3F ) );
+        return 4;
+    }
+}
+
+/* the byte each single-character escape stands for, 0 for the others */
+static const unsigned char lept_escape_value[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0, 34,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 47,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 92,  0,  0,  0,
+     0,  0,  8,  0,  0,  0, 12,  0,  0,  0,  0,  0,  0,  0, 10,  0,
+     0,  0, 13,  0,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+};
+
+/* decodes the escape after a '\\' at *pp into buf (at most 4 bytes) */
+static int lept_parse_escape(const char** pp, char* buf, size_t* n) {
+    const char* p = *pp;
+    unsigned int u, u2;
+    if ((buf[0] = (char)lept_escape_value[(unsigned char)*p]) != '\0') {
+        *n = 1;
+        *pp = p + 1;
+        return LEPT_PARSE_OK;
+    }
+    if (*p++ != 'u') {
+        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+    }
+    /* \uXXXX, or a surrogate pair of them: decoded and encoded in one go */
+    if ( !(p = lept_parse_hex4(p, &u)) ) {
+        return LEPT_PARSE_INVALID_UNICODE_HEX;
+    }
+    if ( u >= 0xD800 && u <= 0xDBFF) {
+        if ( *p++ != '\\') {
+            return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+        }
+        if ( *p++ != 'u') {
+            return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+        }
+        if ( !(p = lept_parse_hex4(p, &u2)) ) {
+            return LEPT_PARSE_INVALID_UNICODE_HEX;
+        }
+        if (u2 < 0xDC00 || u2 > 0xDFFF) {
+            return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+        }
+        u =  (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+    }else if (u >= 0xDC00 && u <= 0xDFFF) {
+        /* a low surrogate with no high one before it */
+        return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+    }
+    *n = lept_encode_utf8(buf, u);
+    *pp = p;
+    return LEPT_PARSE_OK;
+}
+
+/*
+ * Decodes a string into the context stack, or, for lept_parse_insitu(), over
+ * its own escapes in the caller's buffer: decoding never makes a string
+ * longer, so the write cursor never passes the read cursor.
+ */
+static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
+    size_t head = c->top, n, k;
+    const char* p;
+    char* out = NULL;
+    char buf[64];
+    int ret;
+    assert(str != NULL && len != NULL);
+    EXPECT(c, '\"');
+    p = c->json;
+    if (c->flags & LEPT_PARSE_INSITU) {
+        out = *str = (char*)p;
+    }
+    for(;;) {
+        char ch;
+        /* copy the whole run of plain characters with a single push */
+        const char* q = lept_scan_string_impl(p, c->end);
+        if (q != p) {
+            if ((c->flags & LEPT_PARSE_FLAG_VALIDATE_UTF8) && !lept_validate_utf8_impl(p, (size_t)(q - p))) {
+                c->top = head;
+                return LEPT_PARSE_INVALID_UTF8;
+            }
+            if (out == NULL) {
+                PUTS(c, p, (size_t)(q - p));
+            }else {
+                if (out != p) {
+                    memmove(out, p, (size_t)(q - p));
+                }
+                out += q - p;
+            }
+            p = q;
+        }
+        ch = PEEK(c, p);
+        p++;
+        switch (ch) {
+            case '\"':
+                if (out == NULL) {
+                    *len = c->top - head;
+                    *str = (char *) lept_context_pop(c, *len);
+                }else {
+                    *len = (size_t)(out - *str);
+                    *out = '\0';
+                }
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\0': 
+                c->top = head;   /* resume */
+                /* the end, or a raw '\0' inside a length-delimited input */
+                return (c->end == NULL || p - 1 == c->end) ? LEPT_PARSE_MISS_QUOTATION_MARK :
+                                                            LEPT_PARSE_INVALID_STRING_CHAR;
+            case '\\':
+                /* decode a run of escapes, e.g. of \u for non-ASCII text, and store it at once */
+                for (n = 0;;) {
+                    if (c->end != NULL && c->end - p < 11) {
+                        /* closer to the end than the longest escape: decode a padded copy */
+                        char tail[12];
+                        const char* e = tail;
+                        memset(tail, 0, sizeof(tail));
+                        memcpy(tail, p, (size_t)(c->end - p));
+                        ret = lept_parse_escape(&e, buf + n, &k);
+                        p += e - tail;
+                    }else {
+                        ret = lept_parse_escape(&p, buf + n, &k);
+                    }
+                    if (ret != LEPT_PARSE_OK) {
+                        c->top = head;
+                        return ret;
+                    }
+                    n += k;
+                    if (PEEK(c, p) != '\\' || n > sizeof(buf) - 4) {
+                        break;
+                    }
+                    p++;
+                }
+                if (out == NULL) {
+                    PUTS(c, buf, n);
+                }else {
+                    memcpy(out, buf, n);
+                    out += n;
+                }
+                break;
+            default:
+                /* the scanner only stops on '"', '\\' and control characters */
+                assert((unsigned char)ch < 0x20);
+                c->top = head;
+                return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+static int lept_parse_string(lept_context* c, lept_value* v) {
+    int ret;
+    char* s;
+    size_t len;
+    if ( (ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK ) {   
+        if (c->flags & LEPT_PARSE_INSITU) {
+            v->u.s.s = s;
+            v->u.s.len = len;
+            v->type = LEPT_STRING;
+            v->flags = LEPT_VALUE_BORROWED;
+        }else if (c->doc) {
+            v->u.s.s = (char*) lept_arena_alloc(c->doc, len + 1);
+            memcpy(v->u.s.s, s, len);
+            v->u.s.s[len] = '\0';
+            v->u.s.len = len;
+            v->type = LEPT_STRING;
+            v->flags = LEPT_VALUE_BORROWED;
+        }else {
+            lept_set_string_ex(v, s, len, c->alloc);
+        }
+    }
+    return ret;
+}
+
+/*
+ * Arrays and objects are parsed without recursion. Each open container has a
+ * frame on the context stack, followed by the elements (lept_value) or
+ * members (lept_member) parsed so far; a nested container stacks its own
+ * frame on top. Frames are addressed by offset since pushes move the stack.
+ */
+#define LEPT_NO_FRAME ((size_t)-1)
+
+typedef struct {
+    size_t parent;          /* offset of the enclosing frame, or LEPT_NO_FRAME */
+    size_t size;            /* elements or members pushed above the frame */
+    char* k;                /* object: key of the member being parsed */
+    size_t klen;
+    lept_type type;         /* LEPT_ARRAY or LEPT_OBJECT */
+}lept_frame;
+
+#define LEPT_FRAME(c, off) ((lept_frame*)((c)->stack + (off)))
+
+static void lept_free_key(lept_context* c, char* k) {
+    if (k != NULL && !(c->flags & LEPT_PARSE_INSITU) && c->doc == NULL) {
+        LEPT_FREE(c->alloc, k);
+    }
+}
+
+static int lept_parse_key_string(lept_context* c, char** k, size_t* klen) {
+    char* s;
+    int ret;
+    if (PEEK(c, c->json) != '\"') {
+        return LEPT_PARSE_MISS_KEY;
+    }
+    if ((ret = lept_parse_string_raw(c, &s, klen)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    if (c->flags & LEPT_PARSE_INSITU) {
+        *k = s;
+    }else {
+        *k = (char*) lept_context_alloc(c, *klen + 1);
+        memcpy(*k, s, *klen);
+        (*k)[*klen] = '\0';
+    }
+    return LEPT_PARSE_OK;
+}
+
+/* member prefix: key, ':' */
+static int lept_parse_key(lept_context* c, char** k, size_t* klen) {
+    int ret;
+    if ((ret = lept_parse_key_string(c, k, klen)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    lept_parse_whitespace(c);
+    if (PEEK(c, c->json) != ':') {
+        lept_free_key(c, *k);
+        return LEPT_PARSE_MISS_COLON;
+    }
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+static void lept_parse_open(lept_context* c, size_t* frame, lept_type type) {
+    size_t top = c->top;
+    lept_frame* f = (lept_frame*) lept_context_push(c, sizeof(lept_frame));
+    f->parent = *frame;
+    f->size = 0;
+    f->k = NULL;
+    f->klen = 0;
+    f->type = type;
+    *frame = top;
+}
+
+/* pops the innermost container into v */
+static void lept_parse_close(lept_context* c, size_t* frame, lept_value* v) {
+    lept_frame f = *LEPT_FRAME(c, *frame);
+    size_t size;
+    v->type = f.type;
+    if (f.type == LEPT_ARRAY) {
+        v->flags = c->doc ? LEPT_VALUE_BORROWED : 0;
+        v->u.a.size = f.size;
+        v->u.a.e = NULL;
+        if (f.size != 0) {
+            size = f.size * sizeof(lept_value);
+            memcpy((v->u.a.e = lept_context_alloc(c, size)), lept_context_pop(c, size), size);
+        }
+    }else {
+        v->flags = c->doc ? LEPT_VALUE_BORROWED | LEPT_VALUE_BORROWED_KEYS :
+                   (c->flags & LEPT_PARSE_INSITU) ? LEPT_VALUE_BORROWED_KEYS : 0;
+        v->u.o.size = f.size;
+        v->u.o.m = NULL;
+        if (f.size != 0) {
+            size = f.size * sizeof(lept_member);
+            memcpy((v->u.o.m = lept_context_alloc(c, size)), lept_context_pop(c, size), size);
+        }
+    }
+    lept_context_pop(c, sizeof(lept_frame));
+    *frame = f.parent;
+}
+
+/* error: pops and frees the innermost container */
+static void lept_parse_unwind(lept_context* c, size_t* frame) {
+    lept_frame f = *LEPT_FRAME(c, *frame);
+    size_t i;
+    for (i = 0; i < f.size; i++) {
+        if (f.type == LEPT_ARRAY) {
+            lept_free_ex((lept_value*)lept_context_pop(c, sizeof(lept_value)), c->alloc);
+        }else {
+            lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
+            lept_free_key(c, m->k);
+            lept_free_ex(&m->v, c->alloc);
+        }
+    }
+    lept_free_key(c, f.k);
+    lept_context_pop(c, sizeof(lept_frame));
+    *frame = f.parent;
+}
+
+static int lept_parse_value(lept_context* c, lept_value* v) {
+    size_t frame = LEPT_NO_FRAME, depth = 0, klen;
+    lept_frame* f;
+    lept_value e;
+    char* k;
+    int ret;
+
+    for (;;) {
+        /* one value: a scalar completes at once, a container opens a frame */
+        lept_init(&e);
+        switch (lept_value_class[(unsigned char)PEEK(c, c->json)]) {
+            case LEPT_CLASS_NULL   : ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+            case LEPT_CLASS_TRUE   : ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+            case LEPT_CLASS_FALSE  : ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+            case LEPT_CLASS_END    : ret = LEPT_PARSE_EXPECT_VALUE; break;
+            case LEPT_CLASS_STRING : ret = lept_parse_string(c, &e); break;
+            case LEPT_CLASS_NUMBER : ret = lept_parse_number(c, &e); break;
+            case LEPT_CLASS_OPEN   :
+                if (depth == c->max_depth) {
+                    ret = LEPT_PARSE_TOO_DEEP;
+                    break;
+                }
+                lept_parse_open(c, &frame, (*c->json == '[') ? LEPT_ARRAY : LEPT_OBJECT);
+                depth++;
+                c->json++;
+                lept_parse_whitespace(c);
+                f = LEPT_FRAME(c, frame);
+                if (PEEK(c, c->json) == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                    c->json++;
+                    lept_parse_close(c, &frame, &e);
+                    depth--;
+                    ret = LEPT_PARSE_OK;
+                    break;
+                }
+                if (f->type == LEPT_OBJECT) {
+                    if ((ret = lept_parse_key(c, &k, &klen)) != LEPT_PARSE_OK) {
+                        break;
+                    }
+                    f = LEPT_FRAME(c, frame);
+                    f->k = k;
+                    f->klen = klen;
+                }
+                continue;
+            default                : ret = LEPT_PARSE_INVALID_VALUE; break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+        /* e is complete: append it, closing every container that ends here */
+        for (;;) {
+            if (frame == LEPT_NO_FRAME) {
+                *v = e;
+                return LEPT_PARSE_OK;
+            }
+            if (LEPT_FRAME(c, frame)->type == LEPT_ARRAY) {
+                memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
+                f = LEPT_FRAME(c, frame);
+            }else {
+                lept_member* m = (lept_member*) lept_context_push(c, sizeof(lept_member));
+                f = LEPT_FRAME(c, frame);
+                m->k = f->k;
+                m->klen = f->klen;
+                m->v = e;
+                f->k = NULL;
+            }
+            f->size++;
+            lept_parse_whitespace(c);
+            if (PEEK(c, c->json) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                if (f->type == LEPT_OBJECT) {
+                    if ((ret = lept_parse_key(c, &k, &klen)) != LEPT_PARSE_OK) {
+                        break;
+                    }
+                    f = LEPT_FRAME(c, frame);
+                    f->k = k;
+                    f->klen = klen;
+                }
+                ret = LEPT_PARSE_OK;
+                break;
+            }
+            if (PEEK(c, c->json) == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                c->json++;
+                lept_parse_close(c, &frame, &e);
+                depth--;
+                continue;
+            }
+            ret = (f->type == LEPT_ARRAY) ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                            LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+    }
+    while (frame != LEPT_NO_FRAME) {
+        lept_parse_unwind(c, &frame);
+    }
+    return ret;
+}
+
+/*
+ * Skipping: lept_skip_value() checks the value at c->json as
+ * lept_parse_value() would, with the same errors, but builds nothing:
+ * strings are scanned and their escapes checked, not decoded, numbers are
+ * not converted, and each open container keeps only its closing bracket on
+ * the stack. lept_scan_value() just finds where a value ends, for input
+ * that is parsed in full afterwards: brackets are counted, not matched,
+ * strings are followed to their closing quote, and nothing else is checked.
+ */
+static int lept_skip_string(lept_context* c) {
+    const char* p = c->json + 1;
+    const char* e;
+    char buf[4], tail[12];
+    size_t k;
+    int ret;
+    for (;;) {
+        const char* q = lept_scan_string_impl(p, c->end);
+        if ((c->flags & LEPT_PARSE_FLAG_VALIDATE_UTF8) && q != p && !lept_validate_utf8_impl(p, (size_t)(q - p))) {
+            return LEPT_PARSE_INVALID_UTF8;
+        }
+        p = q;
+        switch (PEEK(c, p)) {
+            case '\"':
+                c->json = p + 1;
+                return LEPT_PARSE_OK;
+            case '\0':
+                return (c->end == NULL || p == c->end) ? LEPT_PARSE_MISS_QUOTATION_MARK :
+                                                        LEPT_PARSE_INVALID_STRING_CHAR;
+            case '\\':
+                p++;
+                if (c->end != NULL && c->end - p < 11) {
+                    /* as in lept_parse_string_raw(): a padded copy near the end */
+                    memset(tail, 0, sizeof(tail));
+                    memcpy(tail, p, (size_t)(c->end - p));
+                    e = tail;
+                    ret = lept_parse_escape(&e, buf, &k);
+                    p += e - tail;
+                }else {
+                    ret = lept_parse_escape(&p, buf, &k);
+                }
+                if (ret != LEPT_PARSE_OK) {
+                    return ret;
+                }
+                break;
+            default:
+                return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+/* member prefix, as lept_parse_key() */
+static int lept_skip_key(lept_context* c) {
+    int ret;
+    if (PEEK(c, c->json) != '\"') {
+        return LEPT_PARSE_MISS_KEY;
+    }
+    if ((ret = lept_skip_string(c)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    lept_parse_whitespace(c);
+    if (PEEK(c, c->json) != ':') {
+        return LEPT_PARSE_MISS_COLON;
+    }
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_skip_value(lept_context* c) {
+    size_t base = c->top, depth = 0;
+    int flags = c->flags, ret;
+    lept_value e;
+    char close;
+    c->flags |= LEPT_PARSE_FLAG_LAZY_NUMBER;    /* numbers are checked, not converted */
+    for (;;) {
+        lept_init(&e);
+        switch (lept_value_class[(unsigned char)PEEK(c, c->json)]) {
+            case LEPT_CLASS_NULL   : ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+            case LEPT_CLASS_TRUE   : ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+            case LEPT_CLASS_FALSE  : ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+            case LEPT_CLASS_END    : ret = LEPT_PARSE_EXPECT_VALUE; break;
+            case LEPT_CLASS_STRING : ret = lept_skip_string(c); break;
+            case LEPT_CLASS_NUMBER : ret = lept_parse_number(c, &e); break;
+            case LEPT_CLASS_OPEN   :
+                if (depth == c->max_depth) {
+                    ret = LEPT_PARSE_TOO_DEEP;
+                    break;
+                }
+                close = (*c->json == '[') ? ']' : '}';
+                PUTC(c, close);
+                depth++;
+                c->json++;
+                lept_parse_whitespace(c);
+                if (PEEK(c, c->json) == close) {
+                    c->json++;
+                    c->top--;
+                    depth--;
+                    ret = LEPT_PARSE_OK;
+                    break;
+                }
+                if (close == '}' && (ret = lept_skip_key(c)) != LEPT_PARSE_OK) {
+                    break;
+                }
+                continue;
+            default                : ret = LEPT_PARSE_INVALID_VALUE; break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+        /* a value is complete: step over the ',' after it, or close what ends here */
+        for (;;) {
+            if (depth == 0) {
+                c->flags = flags;
+                return LEPT_PARSE_OK;
+            }
+            close = c->stack[c->top - 1];
+            lept_parse_whitespace(c);
+            if (PEEK(c, c->json) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                ret = (close == '}') ? lept_skip_key(c) : LEPT_PARSE_OK;
+                break;
+            }
+            if (PEEK(c, c->json) == close) {
+                c->json++;
+                c->top--;
+                depth--;
+                continue;
+            }
+            ret = (close == ']') ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+    }
+    c->top = base;
+    c->flags = flags;
+    return ret;
+}
+
+static int lept_scan_value(lept_context* c) {
+    char open = PEEK(c, c->json);
+    size_t depth = 0;
+    int ret;
+    if (open == '\"') {
+        return lept_skip_string(c);
+    }
+    if (open != '[' && open != '{') {
+        /* a scalar runs up to the next whitespace or delimiter */
+        const char* p = c->json;
+        while (p != c->end && *p != '\0' && !IS_WHITESPACE(*p) && *p != ',' && *p != ']' && *p != '}') {
+            p++;
+        }
+        if (p == c->json) {
+            return (PEEK(c, p) == '\0') ? LEPT_PARSE_EXPECT_VALUE : LEPT_PARSE_INVALID_VALUE;
+        }
+        c->json = p;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        c->json = lept_scan_structure_impl(c->json, c->end);
+        switch (PEEK(c, c->json)) {
+            case '\"':
+                if ((ret = lept_skip_string(c)) != LEPT_PARSE_OK) {
+                    return ret;
+                }
+                continue;
+            case '[':
+            case '{':
+                depth++;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0) {
+                    c->json++;
+                    return LEPT_PARSE_OK;
+                }
+                break;
+            default:
+                return open == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+        }
+        c->json++;
+    }
+}
+
+/* a root object of which only the members under one of the n keys are built */
+static int lept_parse_members(lept_context* c, lept_value* v, const char* const* keys, size_t n) {
+    size_t frame = LEPT_NO_FRAME, klen, i;
+    lept_frame* f;
+    lept_member* m;
+    lept_value e;
+    char* s, * k;
+    int ret;
+    lept_parse_open(c, &frame, LEPT_OBJECT);
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c, c->json) != '}') {
+        for (;;) {
+            if (PEEK(c, c->json) != '\"') {
+                ret = LEPT_PARSE_MISS_KEY;
+                break;
+            }
+            if ((ret = lept_parse_string_raw(c, &s, &klen)) != LEPT_PARSE_OK) {
+                break;
+            }
+            for (i = 0; i < n && (strlen(keys[i]) != klen || memcmp(keys[i], s, klen) != 0); i++)
+                ;
+            k = NULL;
+            if (i < n) {
+                k = (char*) lept_context_alloc(c, klen + 1);
+                memcpy(k, s, klen);
+                k[klen] = '\0';
+            }
+            lept_parse_whitespace(c);
+            if (PEEK(c, c->json) != ':') {
+                lept_free_key(c, k);
+                ret = LEPT_PARSE_MISS_COLON;
+                break;
+            }
+            c->json++;
+            lept_parse_whitespace(c);
+            if (k == NULL) {
+                ret = lept_skip_value(c);
+            }else if ((ret = lept_parse_value(c, &e)) == LEPT_PARSE_OK) {
+                m = (lept_member*) lept_context_push(c, sizeof(lept_member));
+                m->k = k;
+                m->klen = klen;
+                m->v = e;
+                f = LEPT_FRAME(c, frame);
+                f->size++;
+            }else {
+                lept_free_key(c, k);
+            }
+            if (ret != LEPT_PARSE_OK) {
+                break;
+            }
+            lept_parse_whitespace(c);
+            if (PEEK(c, c->json) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                continue;
+            }
+            if (PEEK(c, c->json) != '}') {
+                ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            }
+            break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            lept_parse_unwind(c, &frame);
+            return ret;
+        }
+    }
+    c->json++;
+    lept_parse_close(c, &frame, v);
+    return LEPT_PARSE_OK;
+}
+
+/*
+ * Projection (lept_parse_project()): the pointers still to follow at a value
+ * are the remainders of the requested ones, kept on the context stack as a
+ * set of n (const char*) at offset set. A value none of them ends at is a
+ * container filtered down to the children some of them go on into; the
+ * recursion is as deep as the longest pointer, not the input.
+ */
+
+/* whether the next reference token of p is the key s; *next is past it */
+static int lept_pointer_key(const char* p, const char* s, size_t len, const char** next) {
+    const char* end = s + len;
+    for (p++; *p != '/' && *p != '\0'; p++, s++) {
+        char ch = *p;
+        if (ch == '~') {
+            if (p[1] != '0' && p[1] != '1') {
+                return 0;
+            }
+            ch = (*++p == '0') ? '~' : '/';
+        }
+        if (s == end || *s != ch) {
+            return 0;
+        }
+    }
+    *next = p;
+    return s == end;
+}
+
+/* whether the next reference token of p is the array index i */
+static int lept_pointer_index(const char* p, size_t i, const char** next) {
+    size_t n = 0;
+    const char* q = ++p;
+    for (; *q >= '0' && *q <= '9'; q++) {
+        if (n > ((size_t)-1 - 9) / 10) {
+            return 0;
+        }
+        n = n * 10 + (size_t)(*q - '0');
+    }
+    if (q == p || (*p == '0' && q - p > 1) || (*q != '/' && *q != '\0')) {
+        return 0;
+    }
+    *next = q;
+    return n == i;
+}
+
+static int lept_parse_projected(lept_context* c, lept_value* v, size_t set, size_t n, size_t depth) {
+    size_t frame = LEPT_NO_FRAME, max_depth = c->max_depth, klen = 0, kpad = 0, index = 0, sub, m, i;
+    const char** rest = (const char**)(c->stack + set);
+    const char* next;
+    lept_frame* f;
+    lept_value e;
+    char* s, * k = NULL;
+    int ret, match;
+    for (i = 0; i < n && *rest[i] != '\0'; i++)
+        ;
+    if (i < n || (PEEK(c, c->json) != '[' && PEEK(c, c->json) != '{')) {
+        /* a value some pointer ends at, or one none can go into, is built whole */
+        c->max_depth = max_depth - depth;
+        ret = lept_parse_value(c, v);
+        c->max_depth = max_depth;
+        return ret;
+    }
+    if (depth == max_depth) {
+        return LEPT_PARSE_TOO_DEEP;
+    }
+    lept_parse_open(c, &frame, (*c->json == '[') ? LEPT_ARRAY : LEPT_OBJECT);
+    c->json++;
+    lept_parse_whitespace(c);
+    f = LEPT_FRAME(c, frame);
+    if (PEEK(c, c->json) == (f->type == LEPT_ARRAY ? ']' : '}')) {
+        c->json++;
+        lept_parse_close(c, &frame, v);
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        ret = LEPT_PARSE_OK;
+        if (LEPT_FRAME(c, frame)->type == LEPT_OBJECT) {
+            if (PEEK(c, c->json) != '\"') {
+                ret = LEPT_PARSE_MISS_KEY;
+                break;
+            }
+            if ((ret = lept_parse_string_raw(c, &s, &klen)) != LEPT_PARSE_OK) {
+                break;
+            }
+            /* keep the decoded key on the stack, under the set of its child */
+            if ((kpad = LEPT_ALIGN(klen)) != 0) {
+                lept_context_push(c, kpad);
+            }
+        }
+        sub = c->top;
+        for (m = i = 0; i < n; i++) {
+            rest = (const char**)(c->stack + set);
+            if (LEPT_FRAME(c, frame)->type == LEPT_OBJECT) {
+                match = lept_pointer_key(rest[i], c->stack + sub - kpad, klen, &next);
+            }else {
+                match = lept_pointer_index(rest[i], index, &next);
+            }
+            if (match) {
+                *(const char**)lept_context_push(c, sizeof(const char*)) = next;
+                m++;
+            }
+        }
+        if (m != 0 && LEPT_FRAME(c, frame)->type == LEPT_OBJECT) {
+            k = (char*) lept_context_alloc(c, klen + 1);
+            memcpy(k, c->stack + sub - kpad, klen);
+            k[klen] = '\0';
+        }
+        if (LEPT_FRAME(c, frame)->type == LEPT_OBJECT) {
+            lept_parse_whitespace(c);
+            if (PEEK(c, c->json) != ':') {
+                ret = LEPT_PARSE_MISS_COLON;
+            }else {
+                c->json++;
+                lept_parse_whitespace(c);
+            }
+        }
+        if (ret == LEPT_PARSE_OK) {
+            if (m == 0) {
+                /* as deep as lept_parse_projected() would let the child go */
+                c->max_depth = max_depth - depth - 1;
+                ret = lept_skip_value(c);
+                c->max_depth = max_depth;
+            }else {
+                ret = lept_parse_projected(c, &e, sub, m, depth + 1);
+            }
+        }
+        lept_context_pop(c, c->top - sub + kpad);
+        kpad = 0;
+        if (ret != LEPT_PARSE_OK) {
+            lept_free_key(c, k);
+            break;
+        }
+        if (m != 0) {
+            f = LEPT_FRAME(c, frame);
+            if (f->type == LEPT_ARRAY) {
+                memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
+            }else {
+                lept_member* mb = (lept_member*) lept_context_push(c, sizeof(lept_member));
+                mb->k = k;
+                mb->klen = klen;
+                mb->v = e;
+            }
+            LEPT_FRAME(c, frame)->size++;
+        }
+        k = NULL;
+        index++;
+        f = LEPT_FRAME(c, frame);
+        lept_parse_whitespace(c);
+        if (PEEK(c, c->json) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+            continue;
+        }
+        if (PEEK(c, c->json) == (f->type == LEPT_ARRAY ? ']' : '}')) {
+            c->json++;
+            lept_parse_close(c, &frame, v);
+            return LEPT_PARSE_OK;
+        }
+        ret = (f->type == LEPT_ARRAY) ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                        LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+        break;
+    }
+    lept_parse_unwind(c, &frame);
+    return ret;
+}
+
+/*
+ * Two-stage engine (LEPT_PARSE_FLAG_INDEXED). Stage 1 classifies the input 64
+ * bytes at a time and records the offset of every token start: "{}[]:,"
+ * outside strings, opening quotes, and the first byte of other scalars.
+ * Stage 2 walks those offsets to build the tree, so whitespace is never
+ * scanned and every dispatch lands on a token. Stage 1 runs ahead of stage 2
+ * one batch at a time, keeping the index small and in cache; the offset of
+ * the end closes it. A '\0'-terminated input is not measured first: stage 1
+ * finds the terminator in the block that holds it.
+ */
+#ifndef LEPT_INDEX_BATCH
+#define LEPT_INDEX_BATCH 1024
+#endif
+
+typedef struct {
+    const char* json;
+    size_t len, next;       /* input length (LEPT_INDEX_UNKNOWN before the terminator), offset of the next block */
+    lept_uint64 esc_carry, string_carry, scalar_carry;
+    size_t *cur, *end;
+    size_t buf[LEPT_INDEX_BATCH + 64];
+}lept_index;
+
+#define LEPT_INDEX_UNKNOWN ((size_t)-1)
+
+/* prefix xor: bit i of the result is the parity of bits 0..i of x */
+static lept_uint64 lept_prefix_xor(lept_uint64 x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/*
+ * Bytes preceded by an odd run of backslashes, the run starting in this
+ * block or carried in through *carry (1 if the previous block ended with an
+ * unfinished escape).
+ */
+static lept_uint64 lept_index_escaped(lept_uint64 bs, lept_uint64* carry) {
+    const lept_uint64 odd = LEPT_U64(0xAAAAAAAA, 0xAAAAAAAA);
+    lept_uint64 escaped, code;
+    bs &= ~*carry;  /* an escaped backslash escapes nothing */
+    /* subtracting each run from the odd bits leaves parity codes at its end */
+    code = (((bs << 1) | odd) - bs) ^ odd;
+    escaped = code ^ (bs | *carry);
+    *carry = (code & bs) >> 63;
+    return escaped;
+}
+
+static int lept_ctz64(lept_uint64 x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* stage 1: refills the batch; past the input, yields its end again */
+static void lept_index_fill(lept_index* ix) {
+    lept_uint64 m[5], escaped, quote, in_string, scalar, tokens;
+    size_t* out = ix->buf;
+    char tail[64];
+    while (out - ix->buf < LEPT_INDEX_BATCH && ix->next < ix->len) {
+        size_t b = ix->next, n = ix->len - b, i;
+        const char* p = ix->json + b;
+        if (n >= 64 && (ix->len != LEPT_INDEX_UNKNOWN || ((size_t)p & 4095) <= 4096 - 64)) {
+            lept_classify_impl(p, m);
+        }else {
+            /* the last block, or one whose load could cross into an unmapped page */
+            memset(tail, ' ', sizeof(tail));
+            for (i = 0; i < 64 && i < n && (tail[i] = p[i]) != '\0'; i++) {
+            }
+            lept_classify_impl(tail, m);
+        }
+        if (ix->len == LEPT_INDEX_UNKNOWN && m[4] != 0) {
+            /* the terminator: the bytes from it on read as whitespace */
+            int z = lept_ctz64(m[4]);
+            lept_uint64 past = (z == 0) ? ~(lept_uint64)0 : ~(~(lept_uint64)0 >> (64 - z));
+            m[0] &= ~past;
+            m[1] &= ~past;
+            m[2] |= past;
+            m[3] &= ~past;
+            ix->len = b + (size_t)z;
+        }
+        escaped = lept_index_escaped(m[0], &ix->esc_carry);
+        quote = m[1] & ~escaped;
+        /* inside a string: from an opening quote up to (not including) its closing one */
+        in_string = lept_prefix_xor(quote) ^ ix->string_carry;
+        ix->string_carry = 0 - (in_string >> 63);
+        scalar = ~(m[2] | m[3] | quote | in_string);
+        tokens = (m[3] & ~in_string) | (quote & in_string) |
+                 (scalar & ~((scalar << 1) | ix->scalar_carry));
+        ix->scalar_carry = scalar >> 63;
+        while (tokens != 0) {
+            *out++ = b + lept_ctz64(tokens);
+            tokens &= tokens - 1;
+        }
+        ix->next = b + 64;
+    }
+    if (ix->next >= ix->len) {
+        *out++ = ix->len;
+    }
+    ix->cur = ix->buf;
+    ix->end = out;
+}
+
+static size_t lept_index_peek(lept_index* ix) {
+    if (ix->cur == ix->end) {
+        lept_index_fill(ix);
+    }
+    return *ix->cur;
+}
+
+static size_t lept_index_next(lept_index* ix) {
+    size_t off = lept_index_peek(ix);
+    ix->cur++;
+    return off;
+}
+
+/* the byte at a token offset, the end of the input reading as '\0' */
+static char lept_index_byte(const lept_index* ix, size_t off) {
+    return off != ix->len ? ix->json[off] : '\0';
+}
+
+static int lept_parse_indexed_key(lept_context* c, lept_index* ix, char** k, size_t* klen) {
+    int ret;
+    c->json = ix->json + lept_index_next(ix);
+    if ((ret = lept_parse_key_string(c, k, klen)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    /* nothing but whitespace can sit between a key and the next token */
+    if (lept_index_byte(ix, lept_index_next(ix)) != ':') {
+        lept_free_key(c, *k);
+        return LEPT_PARSE_MISS_COLON;
+    }
+    return LEPT_PARSE_OK;
+}
+
+/* stage 2: the loop of lept_parse_value(), reading tokens from ix */
+static int lept_parse_indexed_value(lept_context* c, lept_value* v, lept_index* ix) {
+    const char* json = ix->json;
+    size_t frame = LEPT_NO_FRAME, depth = 0, klen;
+    lept_frame* f;
+    lept_value e;
+    char* k, ch;
+    int ret;
+
+    for (;;) {
+        size_t off = lept_index_next(ix);
+        c->json = json + off;
+        lept_init(&e);
+        switch (lept_value_class[(unsigned char)lept_index_byte(ix, off)]) {
+            case LEPT_CLASS_NULL   : ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+            case LEPT_CLASS_TRUE   : ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+            case LEPT_CLASS_FALSE  : ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+            case LEPT_CLASS_END    : ret = LEPT_PARSE_EXPECT_VALUE; break;
+            case LEPT_CLASS_STRING : ret = lept_parse_string(c, &e); break;
+            case LEPT_CLASS_NUMBER : ret = lept_parse_number(c, &e); break;
+            case LEPT_CLASS_OPEN   :
+                if (depth == c->max_depth) {
+                    ret = LEPT_PARSE_TOO_DEEP;
+                    break;
+                }
+                lept_parse_open(c, &frame, (*c->json == '[') ? LEPT_ARRAY : LEPT_OBJECT);
+                depth++;
+                f = LEPT_FRAME(c, frame);
+                if (lept_index_byte(ix, lept_index_peek(ix)) == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                    ix->cur++;
+                    lept_parse_close(c, &frame, &e);
+                    depth--;
+                    ret = LEPT_PARSE_OK;
+                    break;
+                }
+                if (f->type == LEPT_OBJECT) {
+                    if ((ret = lept_parse_indexed_key(c, ix, &k, &klen)) != LEPT_PARSE_OK) {
+                        break;
+                    }
+                    f = LEPT_FRAME(c, frame);
+                    f->k = k;
+                    f->klen = klen;
+                }
+                continue;
+            default                : ret = LEPT_PARSE_INVALID_VALUE; break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+        /*
+         * a literal or number has to run up to whitespace before the next
+         * token; if it runs on, a ',', a closing bracket or the end is missing
+         */
+        if (e.type != LEPT_STRING && e.type != LEPT_ARRAY && e.type != LEPT_OBJECT &&
+            c->json != json + lept_index_peek(ix)) {
+            lept_parse_whitespace(c);
+            if (c->json != json + lept_index_peek(ix)) {
+                lept_free_ex(&e, c->alloc);
+                ret = (frame == LEPT_NO_FRAME) ? LEPT_PARSE_ROOT_NOT_SINGULAR :
+                      (LEPT_FRAME(c, frame)->type == LEPT_ARRAY) ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                                                   LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                break;
+            }
+        }
+        for (;;) {
+            if (frame == LEPT_NO_FRAME) {
+                if (lept_index_peek(ix) != ix->len) {
+                    lept_free_ex(&e, c->alloc);
+                    return LEPT_PARSE_ROOT_NOT_SINGULAR;
+                }
+                *v = e;
+                return LEPT_PARSE_OK;
+            }
+            if (LEPT_FRAME(c, frame)->type == LEPT_ARRAY) {
+                memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
+                f = LEPT_FRAME(c, frame);
+            }else {
+                lept_member* m = (lept_member*) lept_context_push(c, sizeof(lept_member));
+                f = LEPT_FRAME(c, frame);
+                m->k = f->k;
+                m->klen = f->klen;
+                m->v = e;
+                f->k = NULL;
+            }
+            f->size++;
+            ch = lept_index_byte(ix, lept_index_next(ix));
+            if (ch == ',') {
+                if (f->type == LEPT_OBJECT) {
+                    if ((ret = lept_parse_indexed_key(c, ix, &k, &klen)) != LEPT_PARSE_OK) {
+                        break;
+                    }
+                    f = LEPT_FRAME(c, frame);
+                    f->k = k;
+                    f->klen = klen;
+                }
+                ret = LEPT_PARSE_OK;
+                break;
+            }
+            if (ch == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                lept_parse_close(c, &frame, &e);
+                depth--;
+                continue;
+            }
+            ret = (f->type == LEPT_ARRAY) ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                            LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        }
+        if (ret != LEPT_PARSE_OK) {
+            break;
+        }
+    }
+    while (frame != LEPT_NO_FRAME) {
+        lept_parse_unwind(c, &frame);
+    }
+    return ret;
+}
+
+/* runs both stages over c->json, up to c->end or the terminator */
+static int lept_parse_indexed(lept_context* c, lept_value* v) {
+    lept_index ix;
+    int ret;
+    ix.json = c->json;
+    ix.len = (c->end != NULL) ? (size_t)(c->end - c->json) : LEPT_INDEX_UNKNOWN;
+    ix.next = 0;
+    ix.esc_carry = ix.string_carry = ix.scalar_carry = 0;
+    ix.cur = ix.end = ix.buf;
+    ret = lept_parse_indexed_value(c, v, &ix);
+    c->json = ix.json;
+    return ret;
+}
+
+int lept_parse(lept_value *v, const char *json) {
+    return lept_parse_ex(v, json, LEPT_PARSE_FLAG_DEFAULT, NULL);
+}
+
+/* parses the whole of c->json into v; the caller owns c->stack */
+static int lept_parse_run(lept_context* c, lept_value* v) {
+    int ret = 0;
+    assert(v != NULL && c->json != NULL);
+    c->top = 0;
+    lept_init(v);
+    /* in-situ decoding rewrites strings that stage 1 may not have read yet */
+    if ((c->flags & LEPT_PARSE_FLAG_INDEXED) && !(c->flags & LEPT_PARSE_INSITU)) {
+        ret = lept_parse_indexed(c, v);
+        assert(c->top == 0);
+        return ret;
+    }
+    lept_parse_whitespace(c);
+    if ( (ret = lept_parse_value(c, v)) == LEPT_PARSE_OK ) {
+        lept_parse_whitespace(c);
+        if (c->end != NULL ? c->json != c->end : *c->json != '\0') {
+            lept_free_ex(v, c->alloc);
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c->top == 0);
+    return ret;
+}
+
+static int lept_parse_root(lept_value* v, const char* json, const char* end, int flags, lept_document* doc,
+                           const lept_allocator* a) {
+    int ret;
+    lept_context c;
+    c.json = json;
+    c.end = end;
+    c.stack = NULL;
+    c.size = 0;
+    c.flags = flags;
+    c.max_depth = LEPT_PARSE_MAX_DEPTH;
+    c.doc = doc;
+    c.alloc = doc ? lept_document_allocator(doc) : LEPT_ALLOCATOR(a);
+    ret = lept_parse_run(&c, v);
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    return ret;
+}
+
+int lept_parse_ex(lept_value* v, const char* json, int flags, const lept_allocator* a) {
+    return lept_parse_root(v, json, NULL, flags & ~LEPT_PARSE_INSITU, NULL, a);
+}
+
+int lept_parse_insitu(lept_value* v, char* json) {
+    return lept_parse_root(v, json, NULL, LEPT_PARSE_INSITU, NULL, NULL);
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len) {
+    assert(json != NULL);
+    return lept_parse_root(v, json, json + len, 0, NULL, NULL);
+}
+
+int lept_parse_keys(lept_value* v, const char* json, const char* const* keys, size_t n) {
+    int ret;
+    lept_context c;
+    assert(v != NULL && json != NULL && (keys != NULL || n == 0));
+    c.json = json;
+    c.end = NULL;
+    c.stack = NULL;
+    c.size = 0;
+    c.top = 0;
+    c.flags = 0;
+    c.max_depth = LEPT_PARSE_MAX_DEPTH - 1;    /* under the root object */
+    c.doc = NULL;
+    c.alloc = &lept_std_allocator;
+    lept_init(v);
+    lept_parse_whitespace(&c);
+    if (*c.json == '{') {
+        ret = lept_parse_members(&c, v, keys, n);
+    }else {
+        c.max_depth++;
+        ret = lept_parse_value(&c, v);
+    }
+    if (ret == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (*c.json != '\0') {
+            lept_free_ex(v, c.alloc);
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c.top == 0);
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    return ret;
+}
+
+int lept_parse_project(lept_value* v, const char* json, const char* const* paths, size_t n) {
+    int ret;
+    size_t i;
+    lept_context c;
+    assert(v != NULL && json != NULL && (paths != NULL || n == 0));
+    c.json = json;
+    c.end = NULL;
+    c.stack = NULL;
+    c.size = 0;
+    c.top = 0;
+    c.flags = 0;
+    c.max_depth = LEPT_PARSE_MAX_DEPTH;
+    c.doc = NULL;
+    c.alloc = &lept_std_allocator;
+    lept_init(v);
+    for (i = 0; i < n; i++) {
+        assert(paths[i] != NULL && (*paths[i] == '\0' || *paths[i] == '/'));
+        *(const char**)lept_context_push(&c, sizeof(const char*)) = paths[i];
+    }
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_projected(&c, v, 0, n, 0)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (*c.json != '\0') {
+            lept_free_ex(v, c.alloc);
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    lept_context_pop(&c, n * sizeof(const char*));
+    assert(c.top == 0);
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    return ret;
+}
+
+/* reads a whole file into a buffer from malloc() */
+static char* lept_read_file(const char* path, size_t* len) {
+    const lept_allocator* a = &lept_std_allocator;
+    size_t cap = 4096, n;
+    char* buf;
+    FILE* fp;
+    if ((fp = fopen(path, "rb")) == NULL) {
+        return NULL;
+    }
+    buf = (char*) LEPT_MALLOC(a, cap);
+    *len = 0;
+    while ((n = fread(buf + *len, 1, cap - *len, fp)) != 0) {
+        if ((*len += n) == cap) {
+            cap += cap >> 1;
+            buf = (char*) LEPT_REALLOC(a, buf, cap);
+        }
+    }
+    if (ferror(fp)) {
+        LEPT_FREE(a, buf);
+        buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+}
+
+int lept_parse_file(lept_value* v, const char* path, int flags) {
+    char* buf;
+    size_t len;
+    int ret;
+    assert(v != NULL && path != NULL);
+    flags &= ~(LEPT_PARSE_INSITU | LEPT_PARSE_FLAG_LAZY_NUMBER);
+#ifdef LEPT_MMAP
+    {
+        struct stat st;
+        void* p;
+        int fd;
+        if ((fd = open(path, O_RDONLY)) < 0) {
+            lept_init(v);
+            return LEPT_PARSE_IO_ERROR;
+        }
+        if (fstat(fd, &st) == 0 && st.st_size > 0 && (len = (size_t)st.st_size) == (lept_uint64)st.st_size &&
+            (p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0)) != MAP_FAILED) {
+            close(fd);
+            posix_madvise(p, len, POSIX_MADV_SEQUENTIAL);
+            ret = lept_parse_root(v, (const char*)p, (const char*)p + len, flags, NULL, NULL);
+            munmap(p, len);
+            return ret;
+        }
+        close(fd);
+    }
+#endif
+    if ((buf = lept_read_file(path, &len)) == NULL) {
+        lept_init(v);
+        return LEPT_PARSE_IO_ERROR;
+    }
+    ret = lept_parse_root(v, buf, buf + len, flags, NULL, NULL);
+    LEPT_FREE(&lept_std_allocator, buf);
+    return ret;
+}
+
+/* parser */
+void lept_parser_init(lept_parser* p) {
+    assert(p != NULL);
+    p->stack = NULL;
+    p->size = 0;
+    p->max_retained = 0;
+    p->max_depth = LEPT_PARSE_MAX_DEPTH;
+    p->allocator = NULL;
+}
+
+void lept_parser_set_allocator(lept_parser* p, const lept_allocator* a) {
+    assert(p != NULL && p->stack == NULL);
+    p->allocator = a;
+}
+
+void lept_parser_set_max_depth(lept_parser* p, size_t depth) {
+    assert(p != NULL);
+    p->max_depth = depth;
+}
+
+void lept_parser_set_max_retained(lept_parser* p, size_t bytes) {
+    assert(p != NULL);
+    p->max_retained = bytes;
+}
+
+static int lept_parser_run(lept_parser* p, lept_value* v, const char* json, const char* end, int flags) {
+    int ret;
+    lept_context c;
+    assert(p != NULL);
+    c.json = json;
+    c.end = end;
+    c.stack = p->stack;
+    c.size = p->size;
+    c.flags = flags & ~LEPT_PARSE_INSITU;
+    c.max_depth = (p->max_depth != 0) ? p->max_depth : (size_t)-1;
+    c.doc = NULL;
+    c.alloc = LEPT_ALLOCATOR(p->allocator);
+    ret = lept_parse_run(&c, v);
+    /* keep the grown stack for the next document, trimmed to the cap */
+    if (p->max_retained != 0 && c.size > p->max_retained) {
+        LEPT_FREE(c.alloc, c.stack);
+        c.stack = NULL;
+        c.size = 0;
+    }
+    p->stack = c.stack;
+    p->size = c.size;
+    return ret;
+}
+
+int lept_parser_parse(lept_parser* p, lept_value* v, const char* json, int flags) {
+    return lept_parser_run(p, v, json, NULL, flags);
+}
+
+void lept_parser_free(lept_parser* p) {
+    assert(p != NULL);
+    if (p->stack) {
+        LEPT_FREE(LEPT_ALLOCATOR(p->allocator), p->stack);
+    }
+    lept_parser_init(p);
+}
+
+/* document */
+void lept_document_init(lept_document* d) {
+    assert(d != NULL);
+    lept_init(&d->root);
+    d->chunk = NULL;
+    d->allocator = NULL;
+}
+
+void lept_document_set_allocator(lept_document* d, const lept_allocator* a) {
+    assert(d != NULL && d->chunk == NULL);
+    d->allocator = a;
+}
+
+int lept_document_parse(lept_document* d, const char* json, int flags) {
+    assert(d != NULL);
+    lept_document_reset(d);
+    return lept_parse_root(&d->root, json, NULL, flags & ~LEPT_PARSE_INSITU, d, NULL);
+}
+
+void lept_document_reset(lept_document* d) {
+    lept_chunk* chunk;
+    assert(d != NULL);
+    /* keep only the newest (largest) block for the next parse */
+    if ((chunk = d->chunk) != NULL) {
+        while (chunk->next != NULL) {
+            lept_chunk* next = chunk->next->next;
+            LEPT_FREE(lept_document_allocator(d), chunk->next);
+            chunk->next = next;
+        }
+        chunk->used = 0;
+    }
+    lept_init(&d->root);
+}
+
+void lept_document_free(lept_document* d) {
+    assert(d != NULL);
+    while (d->chunk != NULL) {
+        lept_chunk* next = d->chunk->next;
+        LEPT_FREE(lept_document_allocator(d), d->chunk);
+        d->chunk = next;
+    }
+    lept_init(&d->root);
+}
+
+/*
+ * tape: one word per node, the tag in the top byte and a payload below it.
+ * Numbers carry their bits in a second word, strings their bytes (with a
+ * '\0') in the words that follow. An array or object opens with a word whose
+ * payload is the offset of its closing LEPT_TAPE_END word, whose payload is
+ * in turn the number of elements or members; members are a key string
+ * followed by the value.
+ */
+#define LEPT_TAPE_END        0xFF
+#define LEPT_TAPE_UNSIGNED   0x1    /* LEPT_INTEGER payload: read as uint64 */
+#define LEPT_TAPE_WORD(tag, payload) (((lept_uint64)(tag) << 56) | (lept_uint64)(payload))
+#define LEPT_TAPE_TAG(w)     ((int)((w) >> 56))
+#define LEPT_TAPE_PAYLOAD(w) ((size_t)((w) & LEPT_U64(0x00FFFFFF, 0xFFFFFFFF)))
+
+typedef struct {
+    size_t open;            /* offset of the opening word */
+    size_t size;            /* elements or members so far */
+}lept_tape_frame;
+
+static lept_uint64* lept_tape_push(lept_tape* t, size_t n) {
+    lept_uint64* ret;
+    if (t->size + n > t->capacity) {
+        size_t capacity = t->capacity + (t->capacity >> 1);
+        if (capacity < t->size + n) {
+            capacity = t->size + n;
+        }
+        t->words = (lept_uint64*) LEPT_REALLOC(LEPT_ALLOCATOR(t->allocator), t->words, capacity * sizeof(lept_uint64));
+        t->capacity = capacity;
+    }
+    ret = t->words + t->size;
+    t->size += n;
+    return ret;
+}
+
+static int lept_tape_parse_string(lept_context* c, lept_tape* t) {
+    lept_uint64* w;
+    char* s;
+    size_t len;
+    int ret;
+    if ((ret = lept_parse_string_raw(c, &s, &len)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    w = lept_tape_push(t, len / 8 + 2);
+    w[0] = LEPT_TAPE_WORD(LEPT_STRING, len);
+    w[len / 8 + 1] = 0;
+    memcpy(w + 1, s, len);
+    return LEPT_PARSE_OK;
+}
+
+static int lept_tape_parse_scalar(lept_context* c, lept_tape* t) {
+    lept_value e;
+    lept_uint64* w;
+    int ret;
+    lept_init(&e);
+    switch (*c->json) {
+        case 'n'  : ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+        case 't'  : ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+        case 'f'  : ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+        case '\0' : return LEPT_PARSE_EXPECT_VALUE;
+        case '\"' : return lept_tape_parse_string(c, t);
+        default   :
+            if ((ret = lept_parse_number(c, &e)) != LEPT_PARSE_OK) {
+                return ret;
+            }
+            w = lept_tape_push(t, 2);
+            if (e.type == LEPT_INTEGER) {
+                w[0] = LEPT_TAPE_WORD(LEPT_INTEGER, (e.flags & LEPT_VALUE_UNSIGNED) ? LEPT_TAPE_UNSIGNED : 0);
+                w[1] = (lept_uint64)e.u.i;
+            }else {
+                w[0] = LEPT_TAPE_WORD(LEPT_NUMBER, 0);
+                memcpy(w + 1, &e.u.n, sizeof(double));
+            }
+            return LEPT_PARSE_OK;
+    }
+    if (ret == LEPT_PARSE_OK) {
+        *lept_tape_push(t, 1) = LEPT_TAPE_WORD(e.type, 0);
+    }
+    return ret;
+}
+
+/* member prefix: key, ':' */
+static int lept_tape_parse_key(lept_context* c, lept_tape* t) {
+    int ret;
+    if (*c->json != '\"') {
+        return LEPT_PARSE_MISS_KEY;
+    }
+    if ((ret = lept_tape_parse_string(c, t)) != LEPT_PARSE_OK) {
+        return ret;
+    }
+    lept_parse_whitespace(c);
+    if (*c->json != ':') {
+        return LEPT_PARSE_MISS_COLON;
+    }
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+/* the loop of lept_parse_value(), appending words instead of building nodes */
+static int lept_tape_parse_value(lept_context* c, lept_tape* t) {
+    lept_tape_frame* f;
+    size_t depth = 0;
+    int ret, type;
+
+    for (;;) {
+        if (*c->json == '[' || *c->json == '{') {
+            if (depth == c->max_depth) {
+                return LEPT_PARSE_TOO_DEEP;
+            }
+            type = (*c->json == '[') ? LEPT_ARRAY : LEPT_OBJECT;
+            f = (lept_tape_frame*) lept_context_push(c, sizeof(lept_tape_frame));
+            f->open = t->size;
+            f->size = 0;
+            *lept_tape_push(t, 1) = LEPT_TAPE_WORD(type, 0);
+            depth++;
+            c->json++;
+            lept_parse_whitespace(c);
+            if (*c->json != (type == LEPT_ARRAY ? ']' : '}')) {
+                if (type == LEPT_OBJECT && (ret = lept_tape_parse_key(c, t)) != LEPT_PARSE_OK) {
+                    return ret;
+                }
+                continue;
+            }
+            c->json++;
+            f->size = (size_t)-1;   /* closed below without counting a member */
+        }else if ((ret = lept_tape_parse_scalar(c, t)) != LEPT_PARSE_OK) {
+            return ret;
+        }else if (depth == 0) {
+            return LEPT_PARSE_OK;
+        }else {
+            f = (lept_tape_frame*)(c->stack + c->top - sizeof(lept_tape_frame));
+            lept_parse_whitespace(c);
+        }
+        /* a value is complete: close every container that ends here */
+        for (;;) {
+            type = LEPT_TAPE_TAG(t->words[f->open]);
+            f->size++;
+            if (f->size != 0) {
+                if (*c->json == ',') {
+                    c->json++;
+                    lept_parse_whitespace(c);
+                    if (type == LEPT_OBJECT && (ret = lept_tape_parse_key(c, t)) != LEPT_PARSE_OK) {
+                        return ret;
+                    }
+                    break;
+                }
+                if (*c->json != (type == LEPT_ARRAY ? ']' : '}')) {
+                    return (type == LEPT_ARRAY) ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                                  LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+                }
+                c->json++;
+            }
+            t->words[f->open] = LEPT_TAPE_WORD(type, t->size);
+            *lept_tape_push(t, 1) = LEPT_TAPE_WORD(LEPT_TAPE_END, f->size);
+            lept_context_pop(c, sizeof(lept_tape_frame));
+            if (--depth == 0) {
+                return LEPT_PARSE_OK;
+            }
+            f = (lept_tape_frame*)(c->stack + c->top - sizeof(lept_tape_frame));
+            lept_parse_whitespace(c);
+        }
+    }
+}
+
+void lept_tape_init(lept_tape* t) {
+    assert(t != NULL);
+    t->words = NULL;
+    t->size = t->capacity = 0;
+    t->allocator = NULL;
+}
+
+void lept_tape_set_allocator(lept_tape* t, const lept_allocator* a) {
+    assert(t != NULL && t->words == NULL);
+    t->allocator = a;
+}
+
+int lept_tape_parse(lept_tape* t, const char* json) {
+    lept_context c;
+    int ret;
+    assert(t != NULL && json != NULL);
+    /* first use: size the block from the input rather than growing it from nothing */
+    if (t->capacity == 0) {
+        lept_tape_push(t, strlen(json) / 4 + 16);
+    }
+    t->size = 0;
+    c.json = json;
+    c.end = NULL;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+    c.max_depth = LEPT_PARSE_MAX_DEPTH;
+    c.doc = NULL;
+    c.alloc = LEPT_ALLOCATOR(t->allocator);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_tape_parse_value(&c, t)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (*c.json != '\0') {
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    if (ret != LEPT_PARSE_OK) {
+        t->size = 0;
+    }
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    return ret;
+}
+
+void lept_tape_free(lept_tape* t) {
+    assert(t != NULL);
+    if (t->words) {
+        LEPT_FREE(LEPT_ALLOCATOR(t->allocator), t->words);
+    }
+    lept_tape_init(t);
+}
+
+size_t lept_tape_next(const lept_tape* t, size_t node) {
+    lept_uint64 w;
+    assert(t != NULL && node < t->size);
+    w = t->words[node];
+    switch (LEPT_TAPE_TAG(w)) {
+        case LEPT_NUMBER:
+        case LEPT_INTEGER: return node + 2;
+        case LEPT_STRING:  return node + LEPT_TAPE_PAYLOAD(w) / 8 + 2;
+        case LEPT_ARRAY:
+        case LEPT_OBJECT:  return LEPT_TAPE_PAYLOAD(w) + 1;
+        default:           return node + 1;
+    }
+}
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size);
+    return (lept_type)LEPT_TAPE_TAG(t->words[node]);
+}
+
+int lept_tape_get_boolean(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size);
+    assert(LEPT_TAPE_TAG(t->words[node]) == LEPT_TRUE || LEPT_TAPE_TAG(t->words[node]) == LEPT_FALSE);
+    return LEPT_TAPE_TAG(t->words[node]) == LEPT_TRUE;
+}
+
+double lept_tape_get_number(const lept_tape* t, size_t node) {
+    double n;
+    assert(t != NULL && node < t->size);
+    if (LEPT_TAPE_TAG(t->words[node]) == LEPT_INTEGER) {
+        if (LEPT_TAPE_PAYLOAD(t->words[node]) & LEPT_TAPE_UNSIGNED) {
+            return (double)t->words[node + 1];
+        }
+        return (double)(lept_int64)t->words[node + 1];
+    }
+    assert(LEPT_TAPE_TAG(t->words[node]) == LEPT_NUMBER);
+    memcpy(&n, t->words + node + 1, sizeof(double));
+    return n;
+}
+
+lept_int64 lept_tape_get_int64(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size);
+    assert(LEPT_TAPE_TAG(t->words[node]) == LEPT_INTEGER && !(LEPT_TAPE_PAYLOAD(t->words[node]) & LEPT_TAPE_UNSIGNED));
+    return (lept_int64)t->words[node + 1];
+}
+
+lept_uint64 lept_tape_get_uint64(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_INTEGER);
+    assert((LEPT_TAPE_PAYLOAD(t->words[node]) & LEPT_TAPE_UNSIGNED) || (lept_int64)t->words[node + 1] >= 0);
+    return t->words[node + 1];
+}
+
+const char* lept_tape_get_string(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_STRING);
+    return (const char*)(t->words + node + 1);
+}
+
+size_t lept_tape_get_string_length(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_STRING);
+    return LEPT_TAPE_PAYLOAD(t->words[node]);
+}
+
+size_t lept_tape_get_array_size(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_ARRAY);
+    return LEPT_TAPE_PAYLOAD(t->words[LEPT_TAPE_PAYLOAD(t->words[node])]);
+}
+
+size_t lept_tape_get_array_element(const lept_tape* t, size_t node, size_t index) {
+    size_t e;
+    assert(index < lept_tape_get_array_size(t, node));
+    for (e = node + 1; index != 0; index--) {
+        e = lept_tape_next(t, e);
+    }
+    return e;
+}
+
+size_t lept_tape_get_object_size(const lept_tape* t, size_t node) {
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_OBJECT);
+    return LEPT_TAPE_PAYLOAD(t->words[LEPT_TAPE_PAYLOAD(t->words[node])]);
+}
+
+/* the key node of member index */
+static size_t lept_tape_member(const lept_tape* t, size_t node, size_t index) {
+    size_t m;
+    assert(index < lept_tape_get_object_size(t, node));
+    for (m = node + 1; index != 0; index--) {
+        m = lept_tape_next(t, lept_tape_next(t, m));
+    }
+    return m;
+}
+
+const char* lept_tape_get_object_key(const lept_tape* t, size_t node, size_t index) {
+    return lept_tape_get_string(t, lept_tape_member(t, node, index));
+}
+
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t node, size_t index) {
+    return lept_tape_get_string_length(t, lept_tape_member(t, node, index));
+}
+
+size_t lept_tape_get_object_value(const lept_tape* t, size_t node, size_t index) {
+    return lept_tape_next(t, lept_tape_member(t, node, index));
+}
+
+size_t lept_tape_get_object_value_by_key(const lept_tape* t, size_t node, const char* k, size_t klen) {
+    size_t m, end;
+    assert(t != NULL && node < t->size && LEPT_TAPE_TAG(t->words[node]) == LEPT_OBJECT && k != NULL);
+    end = LEPT_TAPE_PAYLOAD(t->words[node]);
+    for (m = node + 1; m != end; m = lept_tape_next(t, lept_tape_next(t, m))) {
+        if (LEPT_TAPE_PAYLOAD(t->words[m]) == klen && memcmp(t->words + m + 1, k, klen) == 0) {
+            return lept_tape_next(t, m);
+        }
+    }
+    return LEPT_TAPE_NONE;
+}
+
+/*
+ * ondemand: every node is the offset of a value in json, found by skipping
+ * its preceding siblings. Skipping is lept_scan_value(): brackets are
+ * balanced and strings stepped over with the SIMD kernels. The grammar is
+ * checked on the path actually walked, and scalars are decoded by the same
+ * code as lept_parse(), when asked for. The element or member last reached
+ * by index is remembered, so walking a container by increasing index, or
+ * counting it after, goes on from there instead of from its first child.
+ */
+static size_t lept_ondemand_fail(lept_ondemand* d, int error) {
+    if (d->error == LEPT_PARSE_OK) {
+        d->error = error;
+    }
+    return LEPT_ONDEMAND_NONE;
+}
+
+/* a context over p that decodes into the cursor's scratch stack */
+static void lept_ondemand_context(lept_ondemand* d, lept_context* c, const char* p) {
+    c->json = p;
+    c->end = NULL;
+    c->stack = d->stack;
+    c->size = d->size;
+    c->top = 0;
+    c->flags = 0;
+    c->max_depth = LEPT_PARSE_MAX_DEPTH;
+    c->doc = NULL;
+    c->alloc = LEPT_ALLOCATOR(d->allocator);
+}
+
+static const char* lept_ondemand_whitespace(const char* p) {
+    return IS_WHITESPACE(*p) ? lept_skip_whitespace_impl(p, NULL) : p;
+}
+
+/* skips the string at p (its opening quote), NULL on an error */
+static const char* lept_ondemand_skip_string(lept_ondemand* d, const char* p) {
+    lept_context c;
+    int ret;
+    lept_ondemand_context(d, &c, p);
+    if ((ret = lept_skip_string(&c)) != LEPT_PARSE_OK) {
+        lept_ondemand_fail(d, ret);
+        return NULL;
+    }
+    return c.json;
+}
+
+/* skips the value at p as lept_scan_value() does, NULL on an error */
+static const char* lept_ondemand_skip(lept_ondemand* d, const char* p) {
+    lept_context c;
+    int ret;
+    lept_ondemand_context(d, &c, p);
+    if ((ret = lept_scan_value(&c)) != LEPT_PARSE_OK) {
+        lept_ondemand_fail(d, ret);
+        return NULL;
+    }
+    return c.json;
+}
+
+/* from the key at p to its value */
+static const char* lept_ondemand_member(lept_ondemand* d, const char* p) {
+    if (*p != '\"') {
+        lept_ondemand_fail(d, LEPT_PARSE_MISS_KEY);
+        return NULL;
+    }
+    if ((p = lept_ondemand_skip_string(d, p)) == NULL) {
+        return NULL;
+    }
+    p = lept_ondemand_whitespace(p);
+    if (*p != ':') {
+        lept_ondemand_fail(d, LEPT_PARSE_MISS_COLON);
+        return NULL;
+    }
+    return lept_ondemand_whitespace(p + 1);
+}
+
+/* first element or member key of the container at p, NULL if there is none */
+static const char* lept_ondemand_first(const char* p) {
+    p = lept_ondemand_whitespace(p + 1);
+    return (*p == ']' || *p == '}') ? NULL : p;
+}
+
+/* the element or member key following the one at p, NULL after the last one */
+static const char* lept_ondemand_after(lept_ondemand* d, const char* p, char close) {
+    if (close == '}' && (p = lept_ondemand_member(d, p)) == NULL) {
+        return NULL;
+    }
+    if ((p = lept_ondemand_skip(d, p)) == NULL) {
+        return NULL;
+    }
+    p = lept_ondemand_whitespace(p);
+    if (*p == ',') {
+        return lept_ondemand_whitespace(p + 1);
+    }
+    if (*p != close) {
+        lept_ondemand_fail(d, close == ']' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                             LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+    }
+    return NULL;
+}
+
+/*
+ * the element or member key of the container at node from which to walk to
+ * index: the one last visited in it if that is not past index, else the first
+ */
+static const char* lept_ondemand_start(lept_ondemand* d, size_t node, size_t index, size_t* at) {
+    if (d->visited == node && d->visited_index <= index) {
+        *at = d->visited_index;
+        return d->json + d->visited_item;
+    }
+    *at = 0;
+    return lept_ondemand_first(d->json + node);
+}
+
+/* the index-th element or member key of the container at node, NULL if out of range */
+static const char* lept_ondemand_item(lept_ondemand* d, size_t node, char open, size_t index) {
+    const char* p;
+    size_t i;
+    assert(d != NULL);
+    if (node == LEPT_ONDEMAND_NONE) {
+        return NULL;
+    }
+    assert(d->json[node] == open);
+    for (p = lept_ondemand_start(d, node, index, &i); p != NULL && i != index; i++) {
+        p = lept_ondemand_after(d, p, (char)(open + 2));
+    }
+    if (p != NULL) {
+        d->visited = node;
+        d->visited_index = index;
+        d->visited_item = (size_t)(p - d->json);
+    }
+    return p;
+}
+
+static size_t lept_ondemand_count(lept_ondemand* d, size_t node, char open) {
+    const char* p;
+    size_t n;
+    assert(d != NULL && node != LEPT_ONDEMAND_NONE && d->json[node] == open);
+    for (p = lept_ondemand_start(d, node, (size_t)-1, &n); p != NULL; p = lept_ondemand_after(d, p, (char)(open + 2))) {
+        n++;
+    }
+    return n;
+}
+
+/* decodes the string at node into the scratch stack */
+static int lept_ondemand_string(lept_ondemand* d, size_t node) {
+    lept_context c;
+    char* s;
+    int ret;
+    assert(d != NULL && node != LEPT_ONDEMAND_NONE && d->json[node] == '\"');
+    if (d->cached == node) {
+        return LEPT_PARSE_OK;
+    }
+    lept_ondemand_context(d, &c, d->json + node);
+    if ((ret = lept_parse_string_raw(&c, &s, &d->length)) == LEPT_PARSE_OK) {
+        /* still where it was decoded: reclaim it with room for a '\0' */
+        s = (char*)lept_context_push(&c, d->length + 1);
+        s[d->length] = '\0';
+        d->cached = node;
+    }else {
+        lept_ondemand_fail(d, ret);
+    }
+    d->stack = c.stack;
+    d->size = c.size;
+    return ret;
+}
+
+/*
+ * decodes the literal or number at node, on a stack of its own: a number
+ * strtod() has to convert is copied to it, which must not overwrite or move
+ * the decoded string the cursor keeps
+ */
+static int lept_ondemand_scalar(lept_ondemand* d, size_t node, lept_value* e) {
+    lept_context c;
+    int ret;
+    assert(d != NULL && node != LEPT_ONDEMAND_NONE);
+    lept_ondemand_context(d, &c, d->json + node);
+    c.stack = NULL;
+    c.size = 0;
+    lept_init(e);
+    switch (*c.json) {
+        case 'n'  : ret = lept_parse_literal(&c, e, "null", LEPT_NULL); break;
+        case 't'  : ret = lept_parse_literal(&c, e, "true", LEPT_TRUE); break;
+        case 'f'  : ret = lept_parse_literal(&c, e, "false", LEPT_FALSE); break;
+        case '\0' : ret = LEPT_PARSE_EXPECT_VALUE; break;
+        default   : ret = lept_parse_number(&c, e); break;
+    }
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    if (ret != LEPT_PARSE_OK) {
+        lept_ondemand_fail(d, ret);
+    }
+    return ret;
+}
+
+void lept_ondemand_init(lept_ondemand* d, const char* json) {
+    assert(d != NULL && json != NULL);
+    d->json = json;
+    d->stack = NULL;
+    d->size = 0;
+    d->cached = LEPT_ONDEMAND_NONE;
+    d->length = 0;
+    d->visited = LEPT_ONDEMAND_NONE;
+    d->visited_index = 0;
+    d->visited_item = 0;
+    d->error = LEPT_PARSE_OK;
+    d->allocator = NULL;
+}
+
+void lept_ondemand_set_allocator(lept_ondemand* d, const lept_allocator* a) {
+    assert(d != NULL && d->stack == NULL);
+    d->allocator = a;
+}
+
+void lept_ondemand_free(lept_ondemand* d) {
+    assert(d != NULL);
+    if (d->stack) {
+        LEPT_FREE(LEPT_ALLOCATOR(d->allocator), d->stack);
+    }
+    lept_ondemand_init(d, d->json);
+}
+
+int lept_ondemand_get_error(const lept_ondemand* d) {
+    assert(d != NULL);
+    return d->error;
+}
+
+size_t lept_ondemand_root(lept_ondemand* d) {
+    const char* p;
+    assert(d != NULL);
+    p = lept_ondemand_whitespace(d->json);
+    if (*p == '\0') {
+        return lept_ondemand_fail(d, LEPT_PARSE_EXPECT_VALUE);
+    }
+    return (size_t)(p - d->json);
+}
+
+size_t lept_ondemand_next(lept_ondemand* d, size_t node) {
+    const char* p;
+    assert(d != NULL);
+    if (node == LEPT_ONDEMAND_NONE) {
+        return LEPT_ONDEMAND_NONE;
+    }
+    p = lept_ondemand_after(d, d->json + node, ']');
+    return p ? (size_t)(p - d->json) : LEPT_ONDEMAND_NONE;
+}
+
+lept_type lept_ondemand_get_type(lept_ondemand* d, size_t node) {
+    lept_value e;
+    assert(d != NULL && node != LEPT_ONDEMAND_NONE);
+    switch (d->json[node]) {
+        case '\"': return LEPT_STRING;
+        case '[' : return LEPT_ARRAY;
+        case '{' : return LEPT_OBJECT;
+        default  :
+            lept_ondemand_scalar(d, node, &e);
+            return e.type;
+    }
+}
+
+int lept_ondemand_get_boolean(lept_ondemand* d, size_t node) {
+    lept_value e;
+    assert(d != NULL && node != LEPT_ONDEMAND_NONE && (d->json[node] == 't' || d->json[node] == 'f'));
+    return lept_ondemand_scalar(d, node, &e) == LEPT_PARSE_OK && e.type == LEPT_TRUE;
+}
+
+double lept_ondemand_get_number(lept_ondemand* d, size_t node) {
+    lept_value e;
+    if (lept_ondemand_scalar(d, node, &e) != LEPT_PARSE_OK) {
+        return 0.0;
+    }
+    return lept_get_number(&e);
+}
+
+lept_int64 lept_ondemand_get_int64(lept_ondemand* d, size_t node) {
+    lept_value e;
+    if (lept_ondemand_scalar(d, node, &e) != LEPT_PARSE_OK) {
+        return 0;
+    }
+    return lept_get_int64(&e);
+}
+
+lept_uint64 lept_ondemand_get_uint64(lept_ondemand* d, size_t node) {
+    lept_value e;
+    if (lept_ondemand_scalar(d, node, &e) != LEPT_PARSE_OK) {
+        return 0;
+    }
+    return lept_get_uint64(&e);
+}
+
+const char* lept_ondemand_get_string(lept_ondemand* d, size_t node) {
+    return lept_ondemand_string(d, node) == LEPT_PARSE_OK ? d->stack : NULL;
+}
+
+size_t lept_ondemand_get_string_length(lept_ondemand* d, size_t node) {
+    return lept_ondemand_string(d, node) == LEPT_PARSE_OK ? d->length : 0;
+}
+
+size_t lept_ondemand_get_array_size(lept_ondemand* d, size_t node) {
+    return lept_ondemand_count(d, node, '[');
+}
+
+size_t lept_ondemand_get_array_element(lept_ondemand* d, size_t node, size_t index) {
+    const char* p = lept_ondemand_item(d, node, '[', index);
+    return p ? (size_t)(p - d->json) : LEPT_ONDEMAND_NONE;
+}
+
+size_t lept_ondemand_get_object_size(lept_ondemand* d, size_t node) {
+    return lept_ondemand_count(d, node, '{');
+}
+
+const char* lept_ondemand_get_object_key(lept_ondemand* d, size_t node, size_t index) {
+    const char* p = lept_ondemand_item(d, node, '{', index);
+    if (p == NULL) {
+        return NULL;
+    }
+    if (*p != '\"') {
+        lept_ondemand_fail(d, LEPT_PARSE_MISS_KEY);
+        return NULL;
+    }
+    return lept_ondemand_get_string(d, (size_t)(p - d->json));
+}
+
+size_t lept_ondemand_get_object_key_length(lept_ondemand* d, size_t node, size_t index) {
+    const char* p = lept_ondemand_item(d, node, '{', index);
+    if (p == NULL) {
+        return 0;
+    }
+    if (*p != '\"') {
+        lept_ondemand_fail(d, LEPT_PARSE_MISS_KEY);
+        return 0;
+    }
+    return lept_ondemand_get_string_length(d, (size_t)(p - d->json));
+}
+
+size_t lept_ondemand_get_object_value(lept_ondemand* d, size_t node, size_t index) {
+    const char* p = lept_ondemand_item(d, node, '{', index);
+    if (p == NULL || (p = lept_ondemand_member(d, p)) == NULL) {
+        return LEPT_ONDEMAND_NONE;
+    }
+    return (size_t)(p - d->json);
+}
+
+size_t lept_ondemand_get_object_value_by_key(lept_ondemand* d, size_t node, const char* k, size_t klen) {
+    const char *p, *q;
+    assert(k != NULL);
+    if ((p = lept_ondemand_item(d, node, '{', 0)) == NULL) {
+        return LEPT_ONDEMAND_NONE;
+    }
+    for (; p != NULL; p = lept_ondemand_after(d, p, '}')) {
+        if (*p != '\"') {
+            return lept_ondemand_fail(d, LEPT_PARSE_MISS_KEY);
+        }
+        /* compare a key without escapes in place, decode the others */
+        q = lept_scan_string_impl(p + 1, NULL);
+        if (*q == '\"') {
+            if ((size_t)(q - p - 1) != klen || memcmp(p + 1, k, klen) != 0) {
+                continue;
+            }
+        }else if (lept_ondemand_string(d, (size_t)(p - d->json)) != LEPT_PARSE_OK) {
+            return LEPT_ONDEMAND_NONE;
+        }else if (d->length != klen || memcmp(d->stack, k, klen) != 0) {
+            continue;
+        }
+        if ((q = lept_ondemand_member(d, p)) == NULL) {
+            return LEPT_ONDEMAND_NONE;
+        }
+        return (size_t)(q - d->json);
+    }
+    return LEPT_ONDEMAND_NONE;
+}
+
+/*
+ * reader: the grammar as a state machine that stops at every token, on top
+ * of the same tokenizers. Each open container keeps a lept_reader_frame on
+ * the context stack, so memory is bounded by the nesting and the longest
+ * escaped string, never by the size of the document. The context lives in
+ * the reader between tokens.
+ */
+
+/* what the next token may be */
+enum {
+    LEPT_STATE_VALUE,       /* a value */
+    LEPT_STATE_FIRST,       /* the first element or member, or the end of an empty container */
+    LEPT_STATE_AFTER,       /* ',' or the end of the container, or the end of the document */
+    LEPT_STATE_DONE
+};
+
+typedef struct {
+    size_t size;            /* elements or members so far */
+    lept_type type;         /* LEPT_ARRAY or LEPT_OBJECT */
+}lept_reader_frame;
+
+static void lept_reader_load(const lept_reader* r, lept_context* c) {
+    c->json = r->json;
+    c->end = NULL;
+    c->stack = r->stack;
+    c->size = r->size;
+    c->top = r->top;
+    c->flags = 0;
+    c->max_depth = LEPT_PARSE_MAX_DEPTH;
+    c->doc = NULL;
+    c->alloc = LEPT_ALLOCATOR(r->allocator);
+}
+
+static void lept_reader_store(lept_reader* r, const lept_context* c) {
+    r->json = c->json;
+    r->stack = c->stack;
+    r->size = c->size;
+    r->top = c->top;
+}
+
+static lept_token lept_reader_fail(lept_reader* r, int error) {
+    r->error = error;
+    r->state = LEPT_STATE_DONE;
+    return LEPT_TOKEN_ERROR;
+}
+
+/* a string without escapes is handed out where it lies in json */
+static int lept_reader_string(lept_reader* r, lept_context* c) {
+    const char* p = c->json + 1;
+    const char* q = lept_scan_string_impl(p, NULL);
+    char* s;
+    int ret;
+    if (*q == '\"') {
+        r->s = p;
+        r->len = (size_t)(q - p);
+        c->json = q + 1;
+        return LEPT_PARSE_OK;
+    }
+    ret = lept_parse_string_raw(c, &s, &r->len);
+    r->s = s;
+    return ret;
+}
+
+static lept_token lept_reader_key(lept_reader* r, lept_context* c) {
+    int ret;
+    if (*c->json != '\"') {
+        return lept_reader_fail(r, LEPT_PARSE_MISS_KEY);
+    }
+    if ((ret = lept_reader_string(r, c)) != LEPT_PARSE_OK) {
+        return lept_reader_fail(r, ret);
+    }
+    lept_parse_whitespace(c);
+    if (*c->json != ':') {
+        return lept_reader_fail(r, LEPT_PARSE_MISS_COLON);
+    }
+    c->json++;
+    lept_parse_whitespace(c);
+    r->state = LEPT_STATE_VALUE;
+    return LEPT_TOKEN_KEY;
+}
+
+static lept_token lept_reader_close(lept_reader* r, lept_context* c) {
+    lept_reader_frame* f = (lept_reader_frame*) lept_context_pop(c, sizeof(lept_reader_frame));
+    c->json++;
+    r->count = f->size;
+    r->depth--;
+    r->state = LEPT_STATE_AFTER;
+    return f->type == LEPT_ARRAY ? LEPT_TOKEN_END_ARRAY : LEPT_TOKEN_END_OBJECT;
+}
+
+static lept_token lept_reader_step(lept_reader* r, lept_context* c) {
+    lept_reader_frame* f = NULL;
+    int ret;
+    if (r->depth != 0) {
+        f = (lept_reader_frame*)(c->stack + c->top - sizeof(lept_reader_frame));
+    }
+    switch (r->state) {
+        case LEPT_STATE_FIRST:
+            if (*c->json == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                return lept_reader_close(r, c);
+            }
+            if (f->type == LEPT_OBJECT) {
+                return lept_reader_key(r, c);
+            }
+            break;
+        case LEPT_STATE_AFTER:
+            lept_parse_whitespace(c);
+            if (f == NULL) {
+                r->state = LEPT_STATE_DONE;
+                if (*c->json != '\0') {
+                    return lept_reader_fail(r, LEPT_PARSE_ROOT_NOT_SINGULAR);
+                }
+                return LEPT_TOKEN_END;
+            }
+            f->size++;
+            if (*c->json == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                if (f->type == LEPT_OBJECT) {
+                    return lept_reader_key(r, c);
+                }
+                break;
+            }
+            if (*c->json == (f->type == LEPT_ARRAY ? ']' : '}')) {
+                return lept_reader_close(r, c);
+            }
+            return lept_reader_fail(r, f->type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET :
+                                                               LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+        case LEPT_STATE_DONE:
+            return r->error == LEPT_PARSE_OK ? LEPT_TOKEN_END : LEPT_TOKEN_ERROR;
+    }
+    /* a value */
+    r->state = LEPT_STATE_AFTER;
+    lept_init(&r->v);
+    switch (*c->json) {
+        case 'n'  : ret = lept_parse_literal(c, &r->v, "null", LEPT_NULL); break;
+        case 't'  : ret = lept_parse_literal(c, &r->v, "true", LEPT_TRUE); break;
+        case 'f'  : ret = lept_parse_literal(c, &r->v, "false", LEPT_FALSE); break;
+        case '\0' : ret = LEPT_PARSE_EXPECT_VALUE; break;
+        case '\"' :
+            if ((ret = lept_reader_string(r, c)) != LEPT_PARSE_OK) {
+                return lept_reader_fail(r, ret);
+            }
+            return LEPT_TOKEN_STRING;
+        case '['  :
+        case '{'  :
+            if (r->depth == c->max_depth) {
+                return lept_reader_fail(r, LEPT_PARSE_TOO_DEEP);
+            }
+            f = (lept_reader_frame*) lept_context_push(c, sizeof(lept_reader_frame));
+            f->size = 0;
+            f->type = (*c->json == '[') ? LEPT_ARRAY : LEPT_OBJECT;
+            r->depth++;
+            r->state = LEPT_STATE_FIRST;
+            c->json++;
+            lept_parse_whitespace(c);
+            return f->type == LEPT_ARRAY ? LEPT_TOKEN_START_ARRAY : LEPT_TOKEN_START_OBJECT;
+        default   : ret = lept_parse_number(c, &r->v); break;
+    }
+    if (ret != LEPT_PARSE_OK) {
+        return lept_reader_fail(r, ret);
+    }
+    switch (r->v.type) {
+        case LEPT_NULL:  return LEPT_TOKEN_NULL;
+        case LEPT_FALSE: return LEPT_TOKEN_FALSE;
+        case LEPT_TRUE:  return LEPT_TOKEN_TRUE;
+        default:         return LEPT_TOKEN_NUMBER;
+    }
+}
+
+void lept_reader_init(lept_reader* r, const char* json) {
+    lept_context c;
+    assert(r != NULL && json != NULL);
+    r->json = json;
+    r->stack = NULL;
+    r->size = r->top = 0;
+    r->depth = 0;
+    r->state = LEPT_STATE_VALUE;
+    r->error = LEPT_PARSE_OK;
+    lept_init(&r->v);
+    r->s = NULL;
+    r->len = r->count = 0;
+    r->allocator = NULL;
+    lept_reader_load(r, &c);
+    lept_parse_whitespace(&c);
+    lept_reader_store(r, &c);
+}
+
+lept_token lept_reader_next(lept_reader* r) {
+    lept_context c;
+    lept_token t;
+    assert(r != NULL);
+    lept_reader_load(r, &c);
+    t = lept_reader_step(r, &c);
+    lept_reader_store(r, &c);
+    return t;
+}
+
+void lept_reader_set_allocator(lept_reader* r, const lept_allocator* a) {
+    assert(r != NULL && r->stack == NULL);
+    r->allocator = a;
+}
+
+void lept_reader_free(lept_reader* r) {
+    assert(r != NULL);
+    if (r->stack) {
+        LEPT_FREE(LEPT_ALLOCATOR(r->allocator), r->stack);
+    }
+    r->stack = NULL;
+    r->size = r->top = 0;
+}
+
+int lept_reader_get_error(const lept_reader* r) {
+    assert(r != NULL);
+    return r->error;
+}
+
+const lept_value* lept_reader_get_value(const lept_reader* r) {
+    assert(r != NULL);
+    return &r->v;
+}
+
+const char* lept_reader_get_string(const lept_reader* r) {
+    assert(r != NULL);
+    return r->s;
+}
+
+size_t lept_reader_get_string_length(const lept_reader* r) {
+    assert(r != NULL);
+    return r->len;
+}
+
+size_t lept_reader_get_size(const lept_reader* r) {
+    assert(r != NULL);
+    return r->count;
+}
+
+/* sax: the reader's loop, dispatching to the handler */
+int lept_parse_sax(const char* json, const lept_sax_handler* h) {
+    lept_reader r;
+    lept_context c;
+    int ret = LEPT_PARSE_OK, go = 1;
+    assert(json != NULL && h != NULL);
+    lept_reader_init(&r, json);
+    lept_reader_load(&r, &c);
+    while (go) {
+        switch (lept_reader_step(&r, &c)) {
+            case LEPT_TOKEN_NULL:         go = !h->null || h->null(h->user); break;
+            case LEPT_TOKEN_FALSE:        go = !h->boolean || h->boolean(h->user, 0); break;
+            case LEPT_TOKEN_TRUE:         go = !h->boolean || h->boolean(h->user, 1); break;
+            case LEPT_TOKEN_NUMBER:       go = !h->number || h->number(h->user, &r.v); break;
+            case LEPT_TOKEN_STRING:       go = !h->string || h->string(h->user, r.s, r.len); break;
+            case LEPT_TOKEN_KEY:          go = !h->key || h->key(h->user, r.s, r.len); break;
+            case LEPT_TOKEN_START_ARRAY:  go = !h->start_array || h->start_array(h->user); break;
+            case LEPT_TOKEN_END_ARRAY:    go = !h->end_array || h->end_array(h->user, r.count); break;
+            case LEPT_TOKEN_START_OBJECT: go = !h->start_object || h->start_object(h->user); break;
+            case LEPT_TOKEN_END_OBJECT:   go = !h->end_object || h->end_object(h->user, r.count); break;
+            case LEPT_TOKEN_END:
+                go = 0;
+                break;
+            default:
+                ret = r.error;
+                go = 0;
+                continue;
+        }
+        if (!go && r.state != LEPT_STATE_DONE) {
+            ret = LEPT_PARSE_CANCELLED;
+        }
+    }
+    if (c.stack) {
+        LEPT_FREE(c.alloc, c.stack);
+    }
+    return ret;
+}
+
+/*
+ * stream: a reader over a buffer of the input not consumed yet. A step that
+ * reads up to the end of the buffer may have been decided by where the chunk
+ * happened to end rather than by the document; unless the input is over,
+ * such a step is undone and tried again once a later chunk decides it,
+ * which is found by scanning only the bytes that chunk added. The tree
+ * grows from the tokens on the frames of the iterative parser.
+ */
+static const char* lept_stream_space(const char* p, const char* end) {
+    while (p != end && IS_WHITESPACE(*p)) {
+        p++;
+    }
+    return p;
+}
+
+/* how far the scan of an undecided step got, to go on from there with the next chunk */
+enum {
+    LEPT_HOLD_NONE,         /* not scanned */
+    LEPT_HOLD_SPACE,        /* in the whitespace after a ',' */
+    LEPT_HOLD_KEY,          /* in a key */
+    LEPT_HOLD_COLON,        /* in the whitespace after a key */
+    LEPT_HOLD_STRING,       /* in a string value */
+    LEPT_HOLD_WORD          /* in a literal or a number */
+};
+
+/* the string from p (past its opening quote) ends before end; else *p is where to go on */
+static int lept_stream_string_end(const char** p, const char* end) {
+    const char* q = *p;
+    for (;;) {
+        q = lept_scan_string_impl(q, end);
+        if (q == end) {
+            break;
+        }
+        if (*q == '\"') {
+            *p = q + 1;
+            return 1;
+        }
+        if (*q == '\\' && q + 1 == end) {
+            break;
+        }
+        q += (*q == '\\') ? 2 : 1;
+    }
+    *p = q;
+    return 0;
+}
+
+/*
+ * whether the bytes before end decide the step of r from p (not whitespace).
+ * An undecided scan leaves s->hold and s->held saying where it stopped, and
+ * the next call for the same step goes on from there: each byte of a token
+ * split over many chunks is scanned once.
+ */
+static int lept_stream_decided(lept_stream* s, const lept_reader* r, const lept_reader_frame* f, const char* p, const char* end) {
+    int key = (r->state != LEPT_STATE_VALUE && f != NULL && f->type == LEPT_OBJECT);
+    int hold = s->hold;
+    const char* q = p + s->held;
+    s->hold = LEPT_HOLD_NONE;
+    s->held = 0;
+    if (hold == LEPT_HOLD_NONE) {
+        if (r->state == LEPT_STATE_AFTER) {
+            if (f == NULL || *p != ',') {
+                return 1;
+            }
+            q = p + 1;
+            hold = LEPT_HOLD_SPACE;
+        }else if (r->state == LEPT_STATE_FIRST && *p == (f->type == LEPT_ARRAY ? ']' : '}')) {
+            return 1;
+        }
+    }
+    if (hold == LEPT_HOLD_SPACE) {
+        if ((q = lept_stream_space(q, end)) == end) {
+            s->hold = hold;
+            s->held = (size_t)(q - p);
+            return 0;
+        }
+    }
+    if (hold == LEPT_HOLD_NONE || hold == LEPT_HOLD_SPACE) {
+        /* the first byte of the key or the value */
+        if (key) {
+            if (*q != '\"') {
+                return 1;
+            }
+            hold = LEPT_HOLD_KEY;
+        }else if (*q == '\"') {
+            hold = LEPT_HOLD_STRING;
+        }else if (*q == '[' || *q == '{') {
+            return 1;
+        }else {
+            hold = LEPT_HOLD_WORD;
+        }
+        if (hold != LEPT_HOLD_WORD) {
+            q++;
+        }
+    }
+    switch (hold) {
+        case LEPT_HOLD_KEY:
+            if (!lept_stream_string_end(&q, end)) {
+                break;
+            }
+            hold = LEPT_HOLD_COLON;
+            /* ':' or not, after the key */
+            if ((q = lept_stream_space(q, end)) == end) {
+                break;
+            }
+            return 1;
+        case LEPT_HOLD_COLON:
+            if ((q = lept_stream_space(q, end)) == end) {
+                break;
+            }
+            return 1;
+        case LEPT_HOLD_STRING:
+            if (!lept_stream_string_end(&q, end)) {
+                break;
+            }
+            return 1;
+        default:
+            /* a literal or a number runs to the first byte that cannot extend it */
+            while (q != end && (IS_DIGIT(*q) || (*q >= 'a' && *q <= 'z') ||
+                                *q == '.' || *q == '+' || *q == '-' || *q == 'E')) {
+                q++;
+            }
+            if (q != end) {
+                return 1;
+            }
+            break;
+    }
+    s->hold = hold;
+    s->held = (size_t)(q - p);
+    return 0;
+}
+
+static void lept_stream_load(const lept_stream* s, lept_context* b) {
+    b->json = b->end = NULL;
+    b->stack = s->stack;
+    b->size = s->size;
+    b->top = s->top;
+    b->flags = 0;
+    b->max_depth = LEPT_PARSE_MAX_DEPTH;
+    b->doc = NULL;
+    b->alloc = LEPT_ALLOCATOR(s->r.allocator);
+}
+
+/* adds the token t of the reader to the tree */
+static void lept_stream_build(lept_stream* s, lept_context* b, lept_token t) {
+    lept_frame* f;
+    lept_value e;
+    char* k;
+    switch (t) {
+        case LEPT_TOKEN_KEY:
+            k = (char*) lept_context_alloc(b, s->r.len + 1);
+            memcpy(k, s->r.s, s->r.len);
+            k[s->r.len] = '\0';
+            f = LEPT_FRAME(b, s->frame);
+            f->k = k;
+            f->klen = s->r.len;
+            return;
+        case LEPT_TOKEN_START_ARRAY:
+        case LEPT_TOKEN_START_OBJECT:
+            lept_parse_open(b, &s->frame, t == LEPT_TOKEN_START_ARRAY ? LEPT_ARRAY : LEPT_OBJECT);
+            return;
+        case LEPT_TOKEN_END_ARRAY:
+        case LEPT_TOKEN_END_OBJECT:
+            lept_parse_close(b, &s->frame, &e);
+            break;
+        case LEPT_TOKEN_STRING:
+            lept_init(&e);
+            lept_set_string_ex(&e, s->r.s, s->r.len, b->alloc);
+            break;
+        default:
+            e = s->r.v;
+            break;
+    }
+    if (s->frame == LEPT_NO_FRAME) {
+        s->v = e;
+        return;
+    }
+    if (LEPT_FRAME(b, s->frame)->type == LEPT_ARRAY) {
+        memcpy(lept_context_push(b, sizeof(lept_value)), &e, sizeof(lept_value));
+        f = LEPT_FRAME(b, s->frame);
+    }else {
+        lept_member* m = (lept_member*) lept_context_push(b, sizeof(lept_member));
+        f = LEPT_FRAME(b, s->frame);
+        m->k = f->k;
+        m->klen = f->klen;
+        m->v = e;
+        f->k = NULL;
+    }
+    f->size++;
+}
+
+/* consumes the buffer as far as it decides; last: the input ends with it */
+static int lept_stream_run(lept_stream* s, int last) {
+    const char *p, *end = s->buf + s->len;
+    lept_context c, b;
+    lept_reader saved;
+    lept_reader_frame fsaved;
+    size_t top;
+    lept_token t;
+    int decided;
+
+    lept_reader_load(&s->r, &c);
+    c.json = s->buf + s->pos;
+    lept_stream_load(s, &b);
+    for (;;) {
+        lept_parse_whitespace(&c);
+        if ((p = c.json) == end && !last) {
+            break;
+        }
+        saved = s->r;
+        top = c.top;
+        if (s->r.depth != 0) {
+            fsaved = *(lept_reader_frame*)(c.stack + top - sizeof(lept_reader_frame));
+        }
+        decided = 0;
+        if (s->hold != LEPT_HOLD_NONE && !last) {
+            /* the step undone last time: only the new bytes can decide it */
+            if (!lept_stream_decided(s, &saved, saved.depth != 0 ? &fsaved : NULL, p, end)) {
+                break;
+            }
+            decided = 1;
+        }
+        t = lept_reader_step(&s->r, &c);
+        if ((t == LEPT_TOKEN_ERROR || c.json == end) && !last && !decided &&
+            !lept_stream_decided(s, &saved, saved.depth != 0 ? &fsaved : NULL, p, end)) {
+            /* undo the step: its frame is where it was, if popped or counted */
+            s->r = saved;
+            c.json = p;
+            c.top = top;
+            if (saved.depth != 0) {
+                *(lept_reader_frame*)(c.stack + top - sizeof(lept_reader_frame)) = fsaved;
+            }
+            break;
+        }
+        if (t == LEPT_TOKEN_ERROR) {
+            s->error = s->r.error;
+            break;
+        }
+        if (t == LEPT_TOKEN_END) {
+            break;
+        }
+        lept_stream_build(s, &b, t);
+    }
+    s->pos = (size_t)(c.json - s->buf);
+    lept_reader_store(&s->r, &c);
+    s->stack = b.stack;
+    s->size = b.size;
+    s->top = b.top;
+    return s->error;
+}
+
+void lept_stream_set_allocator(lept_stream* s, const lept_allocator* a) {
+    assert(s != NULL && s->buf == NULL);
+    s->r.allocator = a;
+}
+
+void lept_stream_init(lept_stream* s) {
+    assert(s != NULL);
+    lept_reader_init(&s->r, "");
+    s->buf = NULL;
+    s->pos = s->len = s->cap = 0;
+    s->stack = NULL;
+    s->size = s->top = 0;
+    s->frame = LEPT_NO_FRAME;
+    s->held = 0;
+    s->hold = LEPT_HOLD_NONE;
+    lept_init(&s->v);
+    s->error = LEPT_PARSE_OK;
+}
+
+int lept_stream_feed(lept_stream* s, const char* chunk, size_t len) {
+    size_t rest;
+    assert(s != NULL && (chunk != NULL || len == 0));
+    if (s->error != LEPT_PARSE_OK || len == 0) {
+        return s->error;
+    }
+    /*
+     * the chunk goes after the unconsumed tail. Only when it does not fit
+     * does the tail move to the front, and the buffer then grows to keep at
+     * least half of it free, so a long token fed in small chunks is moved
+     * O(1) times per byte.
+     */
+    if (s->len + len + 1 > s->cap) {
+        rest = s->len - s->pos;
+        if (s->buf != NULL) {
+            memmove(s->buf, s->buf + s->pos, rest);
+        }
+        s->pos = 0;
+        s->len = rest;
+        if ((rest + len + 1) * 2 > s->cap) {
+            if (s->cap == 0) {
+                s->cap = LEPT_PARSE_STACK_INIT_SIZE;
+            }
+            while ((rest + len + 1) * 2 > s->cap) {
+                s->cap += s->cap >> 1;
+            }
+            s->buf = (char*) LEPT_REALLOC(LEPT_ALLOCATOR(s->r.allocator), s->buf, s->cap);
+        }
+    }
+    memcpy(s->buf + s->len, chunk, len);
+    s->len += len;
+    s->buf[s->len] = '\0';
+    return lept_stream_run(s, 0);
+}
+
+int lept_stream_finish(lept_stream* s, lept_value* v) {
+    int ret;
+    assert(s != NULL && v != NULL);
+    lept_init(v);
+    if (s->error == LEPT_PARSE_OK && s->buf == NULL) {
+        s->buf = (char*) LEPT_MALLOC(LEPT_ALLOCATOR(s->r.allocator), s->cap = 1);
+        s->buf[0] = '\0';
+    }
+    if ((ret = (s->error != LEPT_PARSE_OK) ? s->error : lept_stream_run(s, 1)) == LEPT_PARSE_OK) {
+        *v = s->v;
+        lept_init(&s->v);
+    }
+    lept_stream_free(s);
+    return ret;
+}
+
+void lept_stream_free(lept_stream* s) {
+    lept_context b;
+    assert(s != NULL);
+    lept_stream_load(s, &b);
+    while (s->frame != LEPT_NO_FRAME) {
+        lept_parse_unwind(&b, &s->frame);
+    }
+    if (b.stack) {
+        LEPT_FREE(b.alloc, b.stack);
+    }
+    if (s->buf) {
+        LEPT_FREE(LEPT_ALLOCATOR(s->r.allocator), s->buf);
+    }
+    lept_reader_free(&s->r);
+    lept_free_ex(&s->v, b.alloc);
+    lept_stream_init(s);
+}
+
+/*
+ * ndjson: the input is cut into batches of whole lines, about
+ * LEPT_NDJSON_BATCH bytes each. Workers claim the next batch under the lock,
+ * parse it outside, and leave the results in a ring of slots that the
+ * calling thread empties in order; a worker waits while the ring is full, so
+ * memory is bounded by the ring rather than by the input.
+ */
+#ifndef LEPT_NDJSON_BATCH
+#define LEPT_NDJSON_BATCH (1 << 16)
+#endif
+
+typedef struct {
+    lept_value v;
+    size_t line;            /* within the batch */
+    int ret;
+}lept_ndjson_result;
+
+typedef struct {
+    const char *begin, *end;
+    lept_ndjson_result* r;
+    size_t n, cap;          /* results */
+    size_t lines;
+    int done;
+}lept_ndjson_batch;
+
+typedef struct {
+    const char *cut, *end;  /* the input not cut into batches yet */
+    lept_ndjson_batch* slots;
+    size_t nslots, next, delivered;     /* batches cut, and handed over */
+    int stop;
+#ifdef LEPT_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+}lept_ndjson;
+
+typedef struct {
+    lept_ndjson* j;
+    lept_parser p;
+#ifdef LEPT_THREADS
+    pthread_t thread;
+#endif
+}lept_ndjson_worker;
+
+static void lept_ndjson_cut(lept_ndjson* j, lept_ndjson_batch* b) {
+    const char* p = j->end;
+    if ((size_t)(j->end - j->cut) > LEPT_NDJSON_BATCH) {
+        p = (const char*) memchr(j->cut + LEPT_NDJSON_BATCH, '\n', (size_t)(j->end - j->cut) - LEPT_NDJSON_BATCH);
+        p = p ? p + 1 : j->end;
+    }
+    b->begin = j->cut;
+    b->end = j->cut = p;
+    b->n = b->lines = 0;
+    b->done = 0;
+}
+
+static void lept_ndjson_parse(lept_ndjson_worker* w, lept_ndjson_batch* b) {
+    const char *p = b->begin, *q;
+    lept_ndjson_result* r;
+    for (; p != b->end; b->lines++) {
+        if ((q = (const char*) memchr(p, '\n', (size_t)(b->end - p))) == NULL) {
+            q = b->end;
+        }
+        if (lept_stream_space(p, q) != q) {
+            if (b->n == b->cap) {
+                b->cap = b->cap ? b->cap + (b->cap >> 1) : 64;
+                b->r = (lept_ndjson_result*) LEPT_REALLOC(&lept_std_allocator, b->r, b->cap * sizeof(lept_ndjson_result));
+            }
+            r = &b->r[b->n++];
+            r->line = b->lines;
+            r->ret = lept_parser_run(&w->p, &r->v, p, q, 0);
+        }
+        p = (q == b->end) ? q : q + 1;
+    }
 }
 
-static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
+/* hands the results over in order, or frees them once stopped; 0 to stop */
+static int lept_ndjson_deliver(lept_ndjson_batch* b, size_t line, int go, lept_ndjson_record record, void* user) {
     size_t i;
-    EXPECT(c, literal[0]);
-    for (i = 0; literal[i+1] ; i++) {
-        if ( c->json[i] != literal[i+1] ) {
-            return LEPT_PARSE_INVALID_VALUE;
+    for (i = 0; i < b->n; i++) {
+        if (go) {
+            go = record(user, line + b->r[i].line, &b->r[i].v, b->r[i].ret);
+        }else {
+            lept_free(&b->r[i].v);
         }
     }
-    c->json += i;
-    v->type = type;
-    return LEPT_PARSE_OK;
-
+    return go;
 }
 
-static int lept_parse_number(lept_context* c, lept_value* v) {
-    /* do something */
-    const char *p = c->json;
-    int state = 1;
-
-    while(state != 0) {
-        switch(state) {
-            case 1:
-                if (*p == '-'){
-                    state = 3; p++;
-                }else if (*p == '0'){
-                    state = 2; p++;
-                }else if ( IS_DIGIT_1_9(*p)) {
-                    state = 4; p++;
-                }else {
-                    return LEPT_PARSE_INVALID_VALUE;
-                }
-                break;
-            case 2:
-                if ( *p == '.') {
-                    state = 5; p++;
-                }else if (*p == 'e' || *p == 'E'){
-                    state = 6; p++;
-                }else {
-                    state = 0;
-                    break; /* end */
-                }
-                break;
-            case 3:
-                if (*p == '0') {
-                    state = 2; p++;
-                }else if ( IS_DIGIT_1_9(*p) ) {
-                    state = 4; p++;
-                }else {
-                    return LEPT_PARSE_INVALID_VALUE; 
-                }
-                break;
-            case 4:
-                if (*p == '.') {
-                    state = 5; p++;
-                }else if ( IS_DIGIT(*p) ) {
-                    state = 4; p++;
-                }else if ( *p == 'e' || *p == 'E') {
-                    state = 6; p++;
-                }else {
-                    state = 0;
-                    break; /* end */
-                }
-                break;
-            case 5:
-                if ( IS_DIGIT(*p) ) {
-                    state = 7; p++;
-                }else {
-                    return LEPT_PARSE_INVALID_VALUE;
-                }
-                break;
-            case 6:
-                if ( IS_DIGIT(*p) ) {
-                    state = 9; p++;
-                }else if ( *p == '+' || *p == '-') {
-                    state = 8; p++;
-                }else {
-                    return LEPT_PARSE_INVALID_VALUE;
-                }
-                break;
-            case 7:
-                if ( IS_DIGIT(*p) ) {
-                    state = 7; p++;
-                }else if ( *p == 'e' || *p == 'E') {
-                    state = 6; p++;
-                }else {
-                    state = 0;
-                    break; /* end */
-                }
-                break;
-            case 8:
-                if ( IS_DIGIT(*p) ) {
-                    state = 9; p++;
-                }else {
-                    return LEPT_PARSE_INVALID_VALUE;
-                }
-                break;
-            case 9:
-                if ( IS_DIGIT(*p) ) {
-                    state = 9; p++;
-                }else {
-                    state = 0;
-                    break; /* end */
-                }
-                break;
-            default: 
-                /* fuck off !! */
-                break;
+#ifdef LEPT_THREADS
+static void* lept_ndjson_thread(void* arg) {
+    lept_ndjson_worker* w = (lept_ndjson_worker*)arg;
+    lept_ndjson* j = w->j;
+    lept_ndjson_batch* b;
+    pthread_mutex_lock(&j->lock);
+    for (;;) {
+        while (!j->stop && j->cut != j->end && j->next - j->delivered == j->nslots) {
+            pthread_cond_wait(&j->cond, &j->lock);
         }
+        if (j->stop || j->cut == j->end) {
+            break;
+        }
+        b = &j->slots[j->next++ % j->nslots];
+        lept_ndjson_cut(j, b);
+        pthread_mutex_unlock(&j->lock);
+        lept_ndjson_parse(w, b);
+        pthread_mutex_lock(&j->lock);
+        b->done = 1;
+        pthread_cond_broadcast(&j->cond);
     }
-    errno = 0;
-    v->u.n = strtod(c->json, NULL);
-    if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n ==-HUGE_VAL)) {
-        return LEPT_PARSE_NUMBER_TOO_BIG;
-    }
-    v->type = LEPT_NUMBER;
-    c->json = p;
-    return LEPT_PARSE_OK;
+    pthread_mutex_unlock(&j->lock);
+    return NULL;
 }
 
-static const char* lept_parse_hex4(const char* p, unsigned int* u) {
-    char ch;
-    short i = 0;
-    *u = 0;
-    for(i = 0; i < 4; i++ ){
-        ch = *p++;
-        *u <<= 4;
-        if (ch >= '0' && ch <= '9'){
-            *u |= (ch - '0');
-        }else if (ch >= 'A' && ch <= 'F') {
-            *u |= (ch - 'A' + 10);
-        }else if (ch >= 'a' && ch <= 'f') {
-            *u |= (ch - 'a' + 10);
-        }else{
-            return NULL;
+/* runs the workers; 0 if none could start */
+static int lept_ndjson_run(lept_ndjson* j, lept_ndjson_worker* w, size_t threads, int* go,
+                           lept_ndjson_record record, void* user) {
+    lept_ndjson_batch* b;
+    size_t i, started = 0, line = 0;
+    pthread_mutex_init(&j->lock, NULL);
+    pthread_cond_init(&j->cond, NULL);
+    for (i = 0; i < threads; i++) {
+        if (pthread_create(&w[started].thread, NULL, lept_ndjson_thread, &w[started]) == 0) {
+            started++;
         }
     }
-    return p;
-}
-
-static void lept_encode_utf8(lept_context* c, unsigned int u) {
-    if (u <= 0x007F) {
-        PUTC(c, u & 0xFF);
-    }else if (u <= 0x07FF ) {
-        PUTC(c, 0xC0 | ( (u >>  6) & 0x1F ) );
-        PUTC(c, 0x80 | (  u        & 0X3F ) );
-    }else if (u <= 0xFFFF ) {
-        PUTC(c, 0xE0 | ( (u >> 12) & 0x0F ) );
-        PUTC(c, 0x80 | ( (u >>  6) & 0x3F ) );
-        PUTC(c, 0x80 | ( (u      ) & 0x3F ) );
-    }else {
-        assert( u <= 0x10FFFF );
-        PUTC(c, 0xF0 | ( (u >> 18) & 0x07 ) );
-        PUTC(c, 0x80 | ( (u >> 12) & 0x3F ) );
-        PUTC(c, 0x80 | ( (u >>  6) & 0x3F ) );
-        PUTC(c, 0x80 | ( (u      ) & 0x3F ) );
+    if (started != 0) {
+        pthread_mutex_lock(&j->lock);
+        for (;;) {
+            b = &j->slots[j->delivered % j->nslots];
+            while (!(j->delivered != j->next && b->done) &&
+                   !(j->delivered == j->next && (j->cut == j->end || j->stop))) {
+                pthread_cond_wait(&j->cond, &j->lock);
+            }
+            if (j->delivered == j->next) {
+                break;
+            }
+            pthread_mutex_unlock(&j->lock);
+            *go = lept_ndjson_deliver(b, line, *go, record, user);
+            line += b->lines;
+            pthread_mutex_lock(&j->lock);
+            j->delivered++;
+            j->stop = !*go;
+            pthread_cond_broadcast(&j->cond);
+        }
+        pthread_mutex_unlock(&j->lock);
+        for (i = 0; i < started; i++) {
+            pthread_join(w[i].thread, NULL);
+        }
     }
+    pthread_cond_destroy(&j->cond);
+    pthread_mutex_destroy(&j->lock);
+    return started != 0;
 }
+#endif
 
-static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
-    unsigned int u, u2;
-    size_t head = c->top;
-    const char* p;
-    assert(str != NULL && len != NULL);
-    EXPECT(c, '\"');
-    p = c->json;
-    for(;;) {
-        char ch = *p++;
-        switch (ch) {
-            case '\"':
-                *len = c->top - head;
-                *str = (char *) lept_context_pop(c, *len);
-                c->json = p;
-                return LEPT_PARSE_OK;
-            case '\0': 
-                c->top = head;   /* resume */
-                return LEPT_PARSE_MISS_QUOTATION_MARK;
-            case '\\':
-                switch (*p ++) {
-                    case '\x22': 
-                        PUTC(c, '\x22'); break;   /* " */
-                    case '\x5C':
-                        PUTC(c, '\x5C'); break;   /* \ */    
-                    case '\x2F':
-                        PUTC(c, '\x2F'); break;   /* / */
-                    case '\x62':
-                        PUTC(c, '\x08'); break;   /* b */
-                    case '\x66':
-                        PUTC(c, '\x0C'); break;   /* f */
-                    case '\x6E': 
-                        PUTC(c, '\x0A'); break;   /* n */
-                    case '\x72':
-                        PUTC(c, '\x0D'); break;   /* r */
-                    case '\x74':
-                        PUTC(c, '\x09'); break;   /* t */
-                    case '\x75':    
-                        /* \uXXXX */  
-                        if ( !(p = lept_parse_hex4(p, &u)) ) {
-                            c->top = head; 
-                            return LEPT_PARSE_INVALID_UNICODE_HEX;
-                        }
-                        if ( u >= 0xD800 && u <= 0xDBFF) {
-                            if ( *p++ != '\\') {
-                                c->top = head; 
-                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
-                            }
-                            if ( *p++ != 'u') {
-                                c->top = head; 
-                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
-                            }
-                            if ( !(p = lept_parse_hex4(p, &u2)) ) {
-                                c->top = head;
-                                return LEPT_PARSE_INVALID_UNICODE_HEX; 
-                            }
-                            if (u2 < 0xDC00 || u2 > 0xDFFF) {
-                                c->top = head;
-                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
-                            }
-                            u =  (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
-                        }
-                        lept_encode_utf8(c, u);
-                        break;
-                    default:
-                        c->top = head;
-                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
-                }
-                break;
-            default:
-                if ((unsigned char)ch < 0x20) {
-                    c->top = head;
-                    return LEPT_PARSE_INVALID_STRING_CHAR;
-                }
-                PUTC(c, ch);
-                break;
+int lept_parse_ndjson(const char* json, size_t len, size_t threads, lept_ndjson_record record, void* user) {
+    const lept_allocator* a = &lept_std_allocator;
+    lept_ndjson j;
+    lept_ndjson_worker* w;
+    size_t i, line = 0;
+    int go = 1, done = 0;
+    assert((json != NULL || len == 0) && record != NULL);
+    if (threads == 0) {
+        threads = 1;
+    }
+    /* resolve the kernels before the threads would race to */
+    lept_get_simd();
+    j.cut = json;
+    j.end = json + len;
+    j.nslots = (threads > 1) ? 2 * threads : 1;
+    j.next = j.delivered = 0;
+    j.stop = 0;
+    j.slots = (lept_ndjson_batch*) LEPT_MALLOC(a, j.nslots * sizeof(lept_ndjson_batch));
+    for (i = 0; i < j.nslots; i++) {
+        j.slots[i].r = NULL;
+        j.slots[i].cap = 0;
+    }
+    w = (lept_ndjson_worker*) LEPT_MALLOC(a, threads * sizeof(lept_ndjson_worker));
+    for (i = 0; i < threads; i++) {
+        w[i].j = &j;
+        lept_parser_init(&w[i].p);
+    }
+#ifdef LEPT_THREADS
+    if (threads > 1) {
+        done = lept_ndjson_run(&j, w, threads, &go, record, user);
+    }
+#endif
+    /* no threads: batch by batch on this one */
+    while (!done && go && j.cut != j.end) {
+        lept_ndjson_cut(&j, &j.slots[0]);
+        lept_ndjson_parse(&w[0], &j.slots[0]);
+        go = lept_ndjson_deliver(&j.slots[0], line, go, record, user);
+        line += j.slots[0].lines;
+    }
+    for (i = 0; i < threads; i++) {
+        lept_parser_free(&w[i].p);
+    }
+    for (i = 0; i < j.nslots; i++) {
+        if (j.slots[i].r) {
+            LEPT_FREE(a, j.slots[i].r);
         }
     }
+    LEPT_FREE(a, w);
+    LEPT_FREE(a, j.slots);
+    return go ? LEPT_PARSE_OK : LEPT_PARSE_CANCELLED;
 }
 
-static int lept_parse_string(lept_context* c, lept_value* v) {
+/*
+ * parallel: a first pass skips from element to element of the root array
+ * with lept_scan_value(), building nothing, and cuts it into pieces of whole
+ * elements, counting them. The array is then allocated at its full size
+ * and workers claim pieces in turn, each parsing its elements straight into
+ * their slots with a context of its own, so nothing is spliced afterwards.
+ * A piece that fails, or does not hold the elements the first pass counted,
+ * sends the whole input back through lept_parse_n() for its error.
+ */
+#ifndef LEPT_PARALLEL_MIN_PIECE
+#define LEPT_PARALLEL_MIN_PIECE (1 << 12)
+#endif
+
+typedef struct {
+    const char *begin, *end;    /* elements and the commas between them */
+    size_t first, size;         /* slots in the array */
+    size_t parsed;
     int ret;
-    char* s;
-    size_t len;
-    if ( (ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK ) {   
-        lept_set_string(v, s, len);
+}lept_parallel_piece;
+
+typedef struct {
+    lept_parallel_piece* pieces;
+    size_t n, cap, next;        /* pieces, and the next one to claim */
+    lept_value* e;
+#ifdef LEPT_THREADS
+    pthread_mutex_t lock;
+#endif
+}lept_parallel;
+
+typedef struct {
+    lept_parallel* a;
+    lept_context c;
+#ifdef LEPT_THREADS
+    pthread_t thread;
+#endif
+}lept_parallel_worker;
+
+static void lept_parallel_add(lept_parallel* a, const char* begin, const char* end, size_t first, size_t size) {
+    lept_parallel_piece* pc;
+    if (a->n == a->cap) {
+        a->cap = a->cap ? a->cap + (a->cap >> 1) : 16;
+        a->pieces = (lept_parallel_piece*) LEPT_REALLOC(&lept_std_allocator, a->pieces, a->cap * sizeof(lept_parallel_piece));
     }
-    return ret;
+    pc = &a->pieces[a->n++];
+    pc->begin = begin;
+    pc->end = end;
+    pc->first = first;
+    pc->size = size;
 }
 
-static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t size = 0;
-    int ret;
-    size_t i;
-    EXPECT(c, '[');
+/* cuts the array at c->json into pieces of about piece bytes; the element count, or (size_t)-1 */
+static size_t lept_parallel_cut(lept_parallel* a, lept_context* c, size_t piece) {
+    const char* begin;
+    size_t count = 0, first = 0;
+    c->json++;
     lept_parse_whitespace(c);
-    if (*(c->json) == ']') {
+    if (PEEK(c, c->json) == ']') {
         c->json++;
-        v->type = LEPT_ARRAY;
-        v->u.a.e = NULL;
-        v->u.a.size = 0;
-        return LEPT_PARSE_OK;
+        return 0;
     }
-    for(;;) {
-        lept_value ev;
-        lept_init(&ev);
-        if ( (ret = lept_parse_value(c, &ev)) != LEPT_PARSE_OK) {
-            break;
+    for (begin = c->json;;) {
+        if (lept_scan_value(c) != LEPT_PARSE_OK) {
+            return (size_t)-1;
         }
-        memcpy(lept_context_push(c, sizeof(lept_value)), &ev, sizeof(lept_value) );
-        size ++;
+        count++;
         lept_parse_whitespace(c);
-        if (*c->json == ']') {
-            /* array parse OK */
-            v->type = LEPT_ARRAY;
-            v->u.a.size = size;
-            size *= sizeof(lept_value);
-            memcpy((v->u.a.e = malloc(size)), lept_context_pop(c, size), size);
+        if (PEEK(c, c->json) == ']') {
+            lept_parallel_add(a, begin, c->json, first, count - first);
             c->json++;
-            return LEPT_PARSE_OK;
+            return count;
         }
-        if (*c->json == ',') {
-            c->json++;
-            lept_parse_whitespace(c);
-            continue;
+        if (PEEK(c, c->json) != ',') {
+            return (size_t)-1;
         }
-        ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;        
-        break;
-    }
-    for(i = 0; i < size; i++ ) {
-        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
+        if ((size_t)(c->json - begin) >= piece) {
+            lept_parallel_add(a, begin, c->json, first, count - first);
+            begin = c->json + 1;
+            first = count;
+        }
+        c->json++;
+        lept_parse_whitespace(c);
     }
-    return ret;
 }
 
-static int lept_parse_object(lept_context* c, lept_value* v) {
-    size_t size = 0, i;
-    lept_member m;
-    int ret;
-    
-    m.k = NULL;
-    m.klen = 0;
-    lept_init(&m.v);
-
-    EXPECT(c, '{');
-    lept_parse_whitespace(c);
-    if (*(c->json) == '}') {
-        c->json++;
-        v->type = LEPT_OBJECT;
-        v->u.o.size = 0;
-        v->u.o.m = NULL;
-        return LEPT_PARSE_OK; 
-    }
-    for(;;) {
-        char* s;
-        m.k = NULL;
-        m.klen = 0;
-        lept_init(&m.v);
-        /* parse key (string)*/
-        if (*c->json != '\"') {
-            ret = LEPT_PARSE_MISS_KEY;
-            break;
-        }
-        if ( (ret = lept_parse_string_raw(c, &s, &(m.klen) ) )  == LEPT_PARSE_OK )  {
-            m.k = (char*) malloc( m.klen + 1 );
-            memcpy(m.k, s, m.klen);
-            m.k[m.klen] = '\0';
-        }else {
-            /* parse key error */
-            break;
-        }
+static void lept_parallel_parse(lept_context* c, lept_parallel_piece* pc, lept_value* e) {
+    c->json = pc->begin;
+    c->end = pc->end;
+    c->top = 0;
+    pc->parsed = 0;
+    for (;;) {
         lept_parse_whitespace(c);
-        if ( *c->json == ':' ) {
-            c->json ++;
-        }else {
-            free(m.k);
-            m.k = NULL;
-            ret = LEPT_PARSE_MISS_COLON;
-            break;
+        if (pc->parsed == pc->size) {
+            pc->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            return;
         }
+        if ((pc->ret = lept_parse_value(c, &e[pc->parsed])) != LEPT_PARSE_OK) {
+            return;
+        }
+        pc->parsed++;
         lept_parse_whitespace(c);
-        if ( (ret = lept_parse_value(c, &(m.v))) != LEPT_PARSE_OK) { 
-            free(m.k);
-            m.k = NULL;
+        if (c->json == c->end) {
             break;
         }
-        size ++;
-        memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member) );
-        lept_parse_whitespace(c);
-        if (*c->json == ',' ) {
-            c->json ++;
-            lept_parse_whitespace(c);
-            continue;
-        }else if (*c->json == '}') {
-            /* end parse object */
-            c->json ++;
-            v->type = LEPT_OBJECT;
-            v->u.o.size = size;
-            size *= sizeof(lept_member);
-            v->u.o.m = (lept_member*) malloc(size);
-            memcpy(v->u.o.m, lept_context_pop(c, size), size);
-            return LEPT_PARSE_OK;
+        if (*c->json != ',') {
+            pc->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            return;
         }
-        ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
-        break;
+        c->json++;
     }
-    /* error */
-    for(i = 0; i < size; i++) {
-        lept_member* pt = lept_context_pop(c, sizeof(lept_member));
-        free(pt->k);
-        lept_free(&pt->v);        
+    if (pc->parsed != pc->size) {
+        pc->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
     }
-    return ret;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v) {
-    switch( *c->json ) {
-        case 'n'  : return lept_parse_literal(c, v, "null", LEPT_NULL);
-        case 't'  : return lept_parse_literal(c, v, "true", LEPT_TRUE);
-        case 'f'  : return lept_parse_literal(c, v, "false", LEPT_FALSE);
-        case '\0' : return LEPT_PARSE_EXPECT_VALUE;
-        case '\"' : return lept_parse_string(c, v);
-        case '['  : return lept_parse_array(c, v);
-        case '{'  : return lept_parse_object(c, v);
-        default :   return lept_parse_number(c, v);
+/* claims and parses pieces until none are left */
+static void* lept_parallel_thread(void* arg) {
+    lept_parallel_worker* w = (lept_parallel_worker*)arg;
+    lept_parallel* a = w->a;
+    lept_parallel_piece* pc;
+    for (;;) {
+#ifdef LEPT_THREADS
+        pthread_mutex_lock(&a->lock);
+#endif
+        pc = (a->next < a->n) ? &a->pieces[a->next++] : NULL;
+#ifdef LEPT_THREADS
+        pthread_mutex_unlock(&a->lock);
+#endif
+        if (pc == NULL) {
+            return NULL;
+        }
+        lept_parallel_parse(&w->c, pc, a->e + pc->first);
     }
 }
 
-int lept_parse(lept_value *v, const char *json) {
-    int ret = 0;
+int lept_parse_parallel(lept_value* v, const char* json, size_t len, size_t threads) {
+    const lept_allocator* al = &lept_std_allocator;
+    lept_parallel a;
+    lept_parallel_worker* w;
     lept_context c;
-    assert(v != NULL);
+    size_t count, piece, i, j;
+    int ret = LEPT_PARSE_OK;
+#ifdef LEPT_THREADS
+    size_t started = 1;
+#endif
+    assert(v != NULL && (json != NULL || len == 0));
     c.json = json;
+    c.end = json + len;
     c.stack = NULL;
-    c.size = c.top = 0;
-    lept_init(v);
+    c.size = 0;
+    c.top = 0;
+    c.flags = 0;
+    c.max_depth = LEPT_PARSE_MAX_DEPTH;
+    c.doc = NULL;
+    c.alloc = al;
     lept_parse_whitespace(&c);
-    if ( (ret = lept_parse_value(&c, v)) == LEPT_PARSE_OK ) {
+    if (threads <= 1 || PEEK(&c, c.json) != '[') {
+        return lept_parse_n(v, json, len);
+    }
+    /* resolve the kernels before the threads would race to */
+    lept_get_simd();
+    a.pieces = NULL;
+    a.n = a.cap = a.next = 0;
+    piece = len / (8 * threads);
+    count = lept_parallel_cut(&a, &c, piece > LEPT_PARALLEL_MIN_PIECE ? piece : LEPT_PARALLEL_MIN_PIECE);
+    if (count != (size_t)-1) {
         lept_parse_whitespace(&c);
-        if ( *(c.json) != '\0') {
-            v->type = LEPT_NULL; 
-            return LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    if (count == (size_t)-1 || c.json != c.end) {
+        if (a.pieces) {
+            LEPT_FREE(al, a.pieces);
         }
+        return lept_parse_n(v, json, len);
     }
-    assert(c.top == 0);
-    free(c.stack);
-    return ret;
+    a.e = count ? (lept_value*) LEPT_MALLOC(al, count * sizeof(lept_value)) : NULL;
+    w = (lept_parallel_worker*) LEPT_MALLOC(al, threads * sizeof(lept_parallel_worker));
+    for (i = 0; i < threads; i++) {
+        w[i].a = &a;
+        w[i].c.stack = NULL;
+        w[i].c.size = 0;
+        w[i].c.flags = 0;
+        w[i].c.max_depth = LEPT_PARSE_MAX_DEPTH - 1;    /* under the root array */
+        w[i].c.doc = NULL;
+        w[i].c.alloc = al;
+    }
+#ifdef LEPT_THREADS
+    pthread_mutex_init(&a.lock, NULL);
+    for (i = 1; i < threads && i < a.n; i++) {
+        if (pthread_create(&w[started].thread, NULL, lept_parallel_thread, &w[started]) == 0) {
+            started++;
+        }
+    }
+#endif
+    /* the calling thread takes pieces too */
+    lept_parallel_thread(&w[0]);
+#ifdef LEPT_THREADS
+    for (i = 1; i < started; i++) {
+        pthread_join(w[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&a.lock);
+#endif
+    for (i = 0; i < threads; i++) {
+        if (w[i].c.stack) {
+            LEPT_FREE(al, w[i].c.stack);
+        }
+    }
+    LEPT_FREE(al, w);
+    for (i = 0; i < a.n && ret == LEPT_PARSE_OK; i++) {
+        ret = a.pieces[i].ret;
+    }
+    if (ret != LEPT_PARSE_OK) {
+        for (i = 0; i < a.n; i++) {
+            for (j = 0; j < a.pieces[i].parsed; j++) {
+                lept_free(&a.e[a.pieces[i].first + j]);
+            }
+        }
+        LEPT_FREE(al, a.e);
+        LEPT_FREE(al, a.pieces);
+        return lept_parse_n(v, json, len);
+    }
+    if (a.pieces) {
+        LEPT_FREE(al, a.pieces);
+    }
+    v->type = LEPT_ARRAY;
+    v->flags = 0;
+    v->u.a.e = a.e;
+    v->u.a.size = count;
+    return LEPT_PARSE_OK;
 }
 
-void lept_free(lept_value* v) {
+/*
+ * Walking a tree: the containers open on the way down are frames on a
+ * context stack, with the index of the child to visit next, so the call
+ * stack does not grow with depth.
+ */
+typedef struct {
+    const lept_value* v;
     size_t i;
-    assert(v != NULL);
-    if (v->type == LEPT_STRING) {
-        free(v->u.s.s);
-    }else if (v->type == LEPT_ARRAY) {
-        for (i = 0; i < v->u.a.size; i++) {
-            lept_free(&v->u.a.e[i]);
+}lept_walk_frame;
+
+#define LEPT_WALK_TOP(w) ((lept_walk_frame*)((w)->stack + (w)->top) - 1)
+
+static void lept_walk_init(lept_context* w, const lept_allocator* a) {
+    memset(w, 0, sizeof(*w));
+    w->alloc = a;
+}
+
+static void lept_walk_open(lept_context* w, const lept_value* v) {
+    lept_walk_frame* f = (lept_walk_frame*) lept_context_push(w, sizeof(lept_walk_frame));
+    f->v = v;
+    f->i = 0;
+}
+
+static void lept_free_value(lept_value* v, const lept_allocator* a) {
+    lept_context w;
+    lept_walk_frame* f;
+    lept_value* e;
+    lept_walk_init(&w, a);
+    for (;;) {
+        /* a container is freed once its children are, the others at once */
+        if (v->type == LEPT_ARRAY || v->type == LEPT_OBJECT) {
+            lept_walk_open(&w, v);
+        }else {
+            if (v->type == LEPT_STRING && !(v->flags & LEPT_VALUE_BORROWED)) {
+                LEPT_FREE(a, v->u.s.s);
+            }
+            v->type = LEPT_NULL;
+            v->flags = 0;
         }
-        free(v->u.a.e);
-    }else if (v->type == LEPT_OBJECT) {
-        for( i = 0; i < v->u.o.size; i++ ) {
-            lept_free( &(v->u.o.m[i].v) );
-            free( v->u.o.m[i].k );
+        /* the next child of the innermost container, freeing those that are done */
+        for (;;) {
+            if (w.top == 0) {
+                if (w.stack) {
+                    LEPT_FREE(a, w.stack);
+                }
+                return;
+            }
+            f = LEPT_WALK_TOP(&w);
+            e = (lept_value*)f->v;
+            if (e->type == LEPT_ARRAY && f->i < e->u.a.size) {
+                v = &e->u.a.e[f->i++];
+                break;
+            }
+            if (e->type == LEPT_OBJECT && f->i < e->u.o.size) {
+                if (!(e->flags & LEPT_VALUE_BORROWED_KEYS)) {
+                    LEPT_FREE(a, e->u.o.m[f->i].k);
+                }
+                v = &e->u.o.m[f->i++].v;
+                break;
+            }
+            if (!(e->flags & LEPT_VALUE_BORROWED)) {
+                LEPT_FREE(a, e->type == LEPT_ARRAY ? (void*)e->u.a.e : (void*)e->u.o.m);
+            }
+            e->type = LEPT_NULL;
+            e->flags = 0;
+            w.top -= sizeof(lept_walk_frame);
         }
-        free(v->u.o.m);
     }
-    v->type = LEPT_NULL;
+}
+
+void lept_free_ex(lept_value* v, const lept_allocator* a) {
+    assert(v != NULL);
+    lept_free_value(v, LEPT_ALLOCATOR(a));
+}
+
+void lept_free(lept_value* v) {
+    lept_free_ex(v, NULL);
 }
 
 lept_type lept_get_type(const lept_value *v) {
@@ -501,7 +5112,31 @@ void lept_set_boolean(lept_value* v, int b) {
 
 /* number */
 double lept_get_number(const lept_value *v) {
-    assert(v!= NULL && v->type == LEPT_NUMBER);
+    assert(v!= NULL && (v->type == LEPT_NUMBER || v->type == LEPT_INTEGER));
+    if (v->flags & LEPT_VALUE_RAW) {
+        /* converted on every call: the value stays const and its literal verbatim */
+        lept_context c;
+        lept_value n;
+        memset(&c, 0, sizeof(c));
+        c.json = v->u.r.p;
+        c.end = v->u.r.p + v->u.r.len;
+        c.flags = LEPT_PARSE_FLAG_DEFAULT;
+        c.max_depth = LEPT_PARSE_MAX_DEPTH;
+        c.alloc = &lept_std_allocator;
+        lept_init(&n);
+        lept_parse_number(&c, &n);
+        assert(n.type == LEPT_NUMBER && c.json == c.end);
+        if (c.stack) {
+            LEPT_FREE(c.alloc, c.stack);
+        }
+        return n.u.n;
+    }
+    if (v->type == LEPT_INTEGER) {
+        if (v->flags & LEPT_VALUE_UNSIGNED) {
+            return (double)(lept_uint64)v->u.i;
+        }
+        return (double)v->u.i;
+    }
     return v->u.n;
 }
 void lept_set_number(lept_value* v, double n) {
@@ -510,6 +5145,31 @@ void lept_set_number(lept_value* v, double n) {
     v->type = LEPT_NUMBER;
 }
 
+/* integer */
+lept_int64 lept_get_int64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_INTEGER && !(v->flags & LEPT_VALUE_UNSIGNED));
+    return v->u.i;
+}
+void lept_set_int64(lept_value* v, lept_int64 i) {
+    lept_free(v);
+    v->u.i = i;
+    v->type = LEPT_INTEGER;
+}
+lept_uint64 lept_get_uint64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_INTEGER && ((v->flags & LEPT_VALUE_UNSIGNED) || v->u.i >= 0));
+    return (lept_uint64)v->u.i;
+}
+void lept_set_uint64(lept_value* v, lept_uint64 u) {
+    lept_free(v);
+    v->u.i = (lept_int64)(u & LEPT_INT64_MAX);
+    if (u > LEPT_INT64_MAX) {
+        /* two's complement bit pattern, spelled without implementation-defined casts */
+        v->u.i = v->u.i - (lept_int64)LEPT_INT64_MAX - 1;
+        v->flags = LEPT_VALUE_UNSIGNED;
+    }
+    v->type = LEPT_INTEGER;
+}
+
 /* string */
 const char* lept_get_string(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
@@ -520,9 +5180,12 @@ size_t lept_get_string_length(const lept_value* v) {
     return v->u.s.len;
 }
 void lept_set_string(lept_value* v, const char* s, size_t len) {
+    lept_set_string_ex(v, s, len, NULL);
+}
+void lept_set_string_ex(lept_value* v, const char* s, size_t len, const lept_allocator* a) {
     assert(v != NULL && (s != NULL ||  len == 0));
-    lept_free(v);
-    v->u.s.s = (char*) malloc(len + 1);
+    lept_free_ex(v, a);
+    v->u.s.s = (char*) LEPT_MALLOC(LEPT_ALLOCATOR(a), len + 1);
     memcpy(v->u.s.s, s, len);
     v->u.s.s[len] = '\0';
     v->u.s.len = len;
@@ -608,54 +5271,92 @@ static int lept_stringify_string(lept_context* c, const char* str, size_t len) {
     return LEPT_STRINGIFY_OK; 
 }
 
-static int lept_stringify_value(lept_context* c, const lept_value* v) {
-    size_t i;
+static void lept_stringify_integer(lept_context* c, const lept_value* v) {
+    char buffer[21];
+    char* p = buffer + sizeof(buffer);
+    lept_uint64 u = (lept_uint64)v->u.i;
+    int neg = !(v->flags & LEPT_VALUE_UNSIGNED) && v->u.i < 0;
+    if (neg) {
+        u = 0 - u;
+    }
+    do {
+        *--p = (char)('0' + (int)(u % 10));
+        u /= 10;
+    } while (u != 0);
+    if (neg) {
+        *--p = '-';
+    }
+    PUTS(c, p, (size_t)(buffer + sizeof(buffer) - p));
+}
 
-    switch (v->type) {
-        case LEPT_NULL:  PUTS(c, "null", 4);break;
-        case LEPT_FALSE: PUTS(c, "false", 5);break;
-        case LEPT_TRUE:  PUTS(c, "true", 4);break;
-        case LEPT_NUMBER:
-            {
-                char* buffer = lept_context_push(c, 32);
-                int length = sprintf(buffer, "%.17g", v->u.n);
-                c->top -= (32 - length);
-            }
-            break;
-        case LEPT_ARRAY:
-            {
+static int lept_stringify_value(lept_context* c, const lept_value* v) {
+    lept_context w;
+    lept_walk_frame* f;
+    const lept_value* e;
+    lept_walk_init(&w, c->alloc);
+    for (;;) {
+        /* one value: a scalar is written at once, a container opens a frame */
+        switch (v->type) {
+            case LEPT_NULL:  PUTS(c, "null", 4);break;
+            case LEPT_FALSE: PUTS(c, "false", 5);break;
+            case LEPT_TRUE:  PUTS(c, "true", 4);break;
+            case LEPT_NUMBER:
+                if (v->flags & LEPT_VALUE_RAW) {
+                    PUTS(c, v->u.r.p, v->u.r.len);
+                }else {
+                    char* buffer = lept_context_push(c, 32);
+                    int length = sprintf(buffer, "%.17g", v->u.n);
+                    c->top -= (32 - length);
+                }
+                break;
+            case LEPT_INTEGER:
+                lept_stringify_integer(c, v);
+                break;
+            case LEPT_ARRAY:
                 PUTC(c, '[');
-                for (i = 0; i < v->u.a.size; i++) {
-                    if (i > 0 ) {
-                        PUTC(c, ',');
-                    }
-                    lept_stringify_value(c, &v->u.a.e[i]); 
+                lept_walk_open(&w, v);
+                break;
+            case LEPT_OBJECT:
+                PUTC(c, '{');
+                lept_walk_open(&w, v);
+                break;
+            case LEPT_STRING:
+                lept_stringify_string(c, v->u.s.s, v->u.s.len);
+                break;
+            default:
+                /* error */
+                break;
+        }
+        /* the next child of the innermost container, closing those that are done */
+        for (;;) {
+            if (w.top == 0) {
+                if (w.stack) {
+                    LEPT_FREE(w.alloc, w.stack);
                 }
-                PUTC(c, ']');
+                return LEPT_STRINGIFY_OK;
             }
-            break;
-        case LEPT_OBJECT: 
-            {
-                PUTC(c, '{');
-                for (i = 0; i < v->u.o.size; i++) {
-                    if ( i > 0) {
-                        PUTC(c, ',');
-                    }
-                    lept_stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
-                    PUTC(c, ':');
-                    lept_stringify_value(c, &v->u.o.m[i].v);
+            f = LEPT_WALK_TOP(&w);
+            e = f->v;
+            if (e->type == LEPT_ARRAY && f->i < e->u.a.size) {
+                if (f->i > 0) {
+                    PUTC(c, ',');
                 }
-                PUTC(c, '}');
+                v = &e->u.a.e[f->i++];
+                break;
             }
-            break;
-        case LEPT_STRING:
-            lept_stringify_string(c, v->u.s.s, v->u.s.len);
-            break;
-        default:
-            /* error */
-            break;
+            if (e->type == LEPT_OBJECT && f->i < e->u.o.size) {
+                if (f->i > 0) {
+                    PUTC(c, ',');
+                }
+                lept_stringify_string(c, e->u.o.m[f->i].k, e->u.o.m[f->i].klen);
+                PUTC(c, ':');
+                v = &e->u.o.m[f->i++].v;
+                break;
+            }
+            PUTC(c, e->type == LEPT_ARRAY ? ']' : '}');
+            w.top -= sizeof(lept_walk_frame);
+        }
     }
-    return LEPT_STRINGIFY_OK;
 }
 
 #ifndef LEPT_PARSE_STRINGIFY_INIT_SIZE
@@ -663,14 +5364,19 @@ static int lept_stringify_value(lept_context* c, const lept_value* v) {
 #endif
 
 int lept_stringify(const lept_value* v, char** json, size_t* length) {
+    return lept_stringify_ex(v, json, length, NULL);
+}
+
+int lept_stringify_ex(const lept_value* v, char** json, size_t* length, const lept_allocator* a) {
     lept_context c;
     int ret;
     assert (v != NULL);
     assert(json != NULL);
-    c.stack = (char*) malloc(c.size = LEPT_PARSE_STRINGIFY_INIT_SIZE);
+    c.alloc = LEPT_ALLOCATOR(a);
+    c.stack = (char*) LEPT_MALLOC(c.alloc, c.size = LEPT_PARSE_STRINGIFY_INIT_SIZE);
     c.top = 0;
     if ((ret = lept_stringify_value(&c, v) ) != LEPT_STRINGIFY_OK) {
-        free(c.stack);
+        LEPT_FREE(c.alloc, c.stack);
         *json = NULL;
         return ret;
     }
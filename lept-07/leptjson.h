@@ -3,7 +3,20 @@
 
 #include <stddef.h> /* size_t */
 
-typedef enum {LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT} lept_type;
+/* 64-bit integers */
+#if defined(_MSC_VER)
+typedef __int64             lept_int64;
+typedef unsigned __int64    lept_uint64;
+#elif defined(__GNUC__)
+__extension__ typedef long long             lept_int64;
+__extension__ typedef unsigned long long    lept_uint64;
+#else
+typedef long long           lept_int64;
+typedef unsigned long long  lept_uint64;
+#endif
+
+/* LEPT_INTEGER: an integral literal (no fraction, no exponent) that fits in int64 or uint64 */
+typedef enum {LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT, LEPT_INTEGER} lept_type;
 
 typedef struct lept_value   lept_value;
 typedef struct lept_member  lept_member;
@@ -14,8 +27,11 @@ struct lept_value{
         struct { lept_value*  e; size_t size; }a;   /* array  */
         struct { char *s; size_t len; }s;           /* string */
         double n;                                   /* number */
+        lept_int64 i;                               /* integer */
+        struct { const char* p; size_t len; }r;     /* lazy number literal */
     }u;
     lept_type type;
+    unsigned int flags;                             /* internal */
 };
 
 struct lept_member {
@@ -23,6 +39,34 @@ struct lept_member {
     lept_value v;
 };
 
+/*
+ * allocator: every allocation of the library goes through one of these,
+ * given per call or per parser, document, tape, cursor, reader or stream; a
+ * NULL one stands for malloc(), realloc() and free(). A tree is released
+ * with the allocator that built it, by lept_free_ex(); lept_free() and the
+ * lept_set_*() release with free().
+ */
+typedef struct {
+    void* (*alloc)  (void* user, size_t size);
+    void* (*realloc)(void* user, void* ptr, size_t size);
+    void  (*free)   (void* user, void* ptr);
+    void* user;
+}lept_allocator;
+
+/*
+ * document: a tree whose nodes, strings and keys are all carved from one
+ * arena, released together by lept_document_reset() or lept_document_free()
+ * without walking the tree. Nodes may still be changed with lept_set_*(),
+ * but whatever those allocate must be released with lept_free() first.
+ */
+typedef struct lept_chunk lept_chunk;
+
+typedef struct {
+    lept_value root;
+    lept_chunk* chunk;      /* internal */
+    const lept_allocator* allocator;    /* internal, see lept_document_set_allocator() */
+}lept_document;
+
 enum {
     LEPT_PARSE_OK = 0,
     LEPT_PARSE_EXPECT_VALUE,
@@ -42,15 +86,315 @@ enum {
     LEPT_PARSE_MISS_KEY,
     LEPT_PARSE_MISS_COLON,
     LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    /* nesting */
+    LEPT_PARSE_TOO_DEEP,
+    /* sax */
+    LEPT_PARSE_CANCELLED,
+    /* file */
+    LEPT_PARSE_IO_ERROR,
+    /* utf-8 */
+    LEPT_PARSE_INVALID_UTF8,
     /* stringify */
     LEPT_STRINGIFY_OK
 };
 
-#define lept_init(v)  do{(v)->type = LEPT_NULL;}while(0)
+/* nesting limit of lept_parse(), lept_parse_ex() and documents */
+#ifndef LEPT_PARSE_MAX_DEPTH
+#define LEPT_PARSE_MAX_DEPTH 1024
+#endif
+
+#define lept_init(v)  do{(v)->type = LEPT_NULL; (v)->flags = 0;}while(0)
+
+/* lept_parse_ex() flags */
+enum {
+    LEPT_PARSE_FLAG_DEFAULT     = 0,
+    /*
+     * Numbers with a fraction or exponent keep a pointer to their literal in
+     * json, which must outlive the value. lept_get_number() converts it on
+     * each call and lept_stringify() copies it verbatim.
+     */
+    LEPT_PARSE_FLAG_LAZY_NUMBER = 1 << 0,
+    /*
+     * Two-stage engine: a SIMD pass indexes the tokens of json ahead of the
+     * pass that builds the tree from that index. Same results and errors as
+     * the default engine. lept_parse_insitu() and lept_parse_n(), which take
+     * no flags, always use the default one.
+     */
+    LEPT_PARSE_FLAG_INDEXED     = 1 << 1,
+    /*
+     * Strings must be well-formed UTF-8, or the parse fails with
+     * LEPT_PARSE_INVALID_UTF8; checked as they are scanned.
+     */
+    LEPT_PARSE_FLAG_VALIDATE_UTF8 = 1 << 2
+};
 
 int lept_parse(lept_value *v, const char *json);
+int lept_parse_ex(lept_value *v, const char *json, int flags, const lept_allocator *a);
+
+/*
+ * In-situ parse: escapes are decoded in place and string values and object
+ * keys point into json, which must outlive v. json is modified even when the
+ * parse fails.
+ */
+int lept_parse_insitu(lept_value *v, char *json);
+
+/*
+ * Length-delimited parse: json need not be '\0'-terminated, the parse ends
+ * at json + len. A '\0' may only appear in a string, escaped as \u0000.
+ */
+int lept_parse_n(lept_value *v, const char *json, size_t len);
+
+/*
+ * Member filter: as lept_parse(), but of a root object only the members
+ * whose key is one of the n keys are built, in document order. The values
+ * of the others are skipped without decoding or allocating, but checked as
+ * lept_parse() checks them, with the same errors. A root of another type is
+ * parsed whole.
+ */
+int lept_parse_keys(lept_value *v, const char *json, const char *const *keys, size_t n);
+
+/*
+ * Projection: as lept_parse(), but only the values on the way to one of the
+ * n JSON Pointers (RFC 6901) in paths are built. A container on the way
+ * keeps, in document order, just the elements or members some pointer goes
+ * on into, so array indices are not preserved; a value a pointer ends at,
+ * or a scalar one would go into, is built whole. Everything else is skipped
+ * as by lept_parse_keys().
+ */
+int lept_parse_project(lept_value *v, const char *json, const char *const *paths, size_t n);
+
+/*
+ * File parse: the file is mapped read-only and parsed where it lies, with no
+ * copy, where the system allows; otherwise it is read into a buffer. Flags
+ * are those of lept_parse_ex(), LEPT_PARSE_FLAG_INDEXED included, but
+ * LEPT_PARSE_FLAG_LAZY_NUMBER, as the mapping is gone on return. A file that
+ * cannot be opened or read gives LEPT_PARSE_IO_ERROR.
+ */
+int lept_parse_file(lept_value *v, const char *path, int flags);
+
+/*
+ * parser: keeps its scratch stack from one lept_parser_parse() to the next,
+ * so steady-state parsing does no stack reallocation. A stack grown beyond
+ * max_retained bytes (0: no limit) is released after the parse. The stack
+ * and the trees parsed come from its allocator.
+ */
+typedef struct {
+    char* stack;            /* internal */
+    size_t size;            /* internal: bytes held by stack */
+    size_t max_retained;
+    size_t max_depth;       /* LEPT_PARSE_MAX_DEPTH unless set, 0: no limit */
+    const lept_allocator* allocator;    /* internal, see lept_parser_set_allocator() */
+}lept_parser;
+
+void lept_parser_init             (lept_parser *p);
+void lept_parser_set_max_retained (lept_parser *p, size_t bytes);
+void lept_parser_set_max_depth    (lept_parser *p, size_t depth);
+void lept_parser_set_allocator    (lept_parser *p, const lept_allocator *a);  /* before the first parse */
+int  lept_parser_parse            (lept_parser *p, lept_value *v, const char *json, int flags);
+void lept_parser_free             (lept_parser *p);
+
+/* document */
+void lept_document_init  (lept_document *d);
+void lept_document_set_allocator(lept_document *d, const lept_allocator *a);  /* before the first parse */
+int  lept_document_parse (lept_document *d, const char *json, int flags);
+void lept_document_reset (lept_document *d);   /* drops the tree, keeps the largest block */
+void lept_document_free  (lept_document *d);
+
+/*
+ * tape: a read-only tree in one block of tagged 64-bit words, strings
+ * inline, each container knowing where it ends. Nodes are word offsets, the
+ * root is 0 and LEPT_TAPE_NONE stands for no node. Element and member access
+ * by index walks the preceding siblings; lept_tape_next() steps over a whole
+ * subtree. The block comes from the tape's allocator and is kept for the
+ * next lept_tape_parse().
+ */
+typedef struct {
+    lept_uint64* words;     /* internal */
+    size_t size, capacity;  /* internal: words used and allocated */
+    const lept_allocator* allocator;    /* internal */
+}lept_tape;
+
+#define LEPT_TAPE_NONE ((size_t)-1)
+
+void   lept_tape_init  (lept_tape *t);
+void   lept_tape_set_allocator(lept_tape *t, const lept_allocator *a);    /* before the first parse */
+int    lept_tape_parse (lept_tape *t, const char *json);
+void   lept_tape_free  (lept_tape *t);
+size_t lept_tape_next  (const lept_tape *t, size_t node);
+
+lept_type   lept_tape_get_type          (const lept_tape *t, size_t node);
+int         lept_tape_get_boolean       (const lept_tape *t, size_t node);
+double      lept_tape_get_number        (const lept_tape *t, size_t node);
+lept_int64  lept_tape_get_int64         (const lept_tape *t, size_t node);
+lept_uint64 lept_tape_get_uint64        (const lept_tape *t, size_t node);
+const char* lept_tape_get_string        (const lept_tape *t, size_t node);
+size_t      lept_tape_get_string_length (const lept_tape *t, size_t node);
+size_t      lept_tape_get_array_size    (const lept_tape *t, size_t node);
+size_t      lept_tape_get_array_element (const lept_tape *t, size_t node, size_t index);
+size_t      lept_tape_get_object_size   (const lept_tape *t, size_t node);
+const char* lept_tape_get_object_key    (const lept_tape *t, size_t node, size_t index);
+size_t      lept_tape_get_object_key_length(const lept_tape *t, size_t node, size_t index);
+size_t      lept_tape_get_object_value  (const lept_tape *t, size_t node, size_t index);
+size_t      lept_tape_get_object_value_by_key(const lept_tape *t, size_t node, const char *k, size_t klen);
+
+/*
+ * ondemand: a cursor over json that builds nothing. Nodes are offsets of
+ * values in json, the root from lept_ondemand_root(), LEPT_ONDEMAND_NONE
+ * for no node; lookups given LEPT_ONDEMAND_NONE return it. Subtrees that
+ * are not walked are skipped checking only brackets and strings, and
+ * scalars are decoded on each call. Errors met on the way are kept in
+ * lept_ondemand_get_error(). A returned string lives in the cursor until
+ * the next string or key is read. lept_ondemand_next() steps over an array
+ * element. Indexing a container at increasing indices, or counting it after
+ * indexing, goes on from the child last reached instead of its first one.
+ */
+typedef struct {
+    const char* json;       /* internal */
+    char* stack;            /* internal: the last string decoded */
+    size_t size;            /* internal */
+    size_t cached, length;  /* internal: its node and length */
+    size_t visited, visited_index, visited_item;    /* internal: the child last reached by index */
+    int error;              /* internal */
+    const lept_allocator* allocator;    /* internal */
+}lept_ondemand;
+
+#define LEPT_ONDEMAND_NONE ((size_t)-1)
+
+void   lept_ondemand_init      (lept_ondemand *d, const char *json);
+void   lept_ondemand_set_allocator(lept_ondemand *d, const lept_allocator *a);  /* before the first string */
+void   lept_ondemand_free      (lept_ondemand *d);
+int    lept_ondemand_get_error (const lept_ondemand *d);
+size_t lept_ondemand_root      (lept_ondemand *d);
+size_t lept_ondemand_next      (lept_ondemand *d, size_t node);
+
+lept_type   lept_ondemand_get_type          (lept_ondemand *d, size_t node);
+int         lept_ondemand_get_boolean       (lept_ondemand *d, size_t node);
+double      lept_ondemand_get_number        (lept_ondemand *d, size_t node);
+lept_int64  lept_ondemand_get_int64         (lept_ondemand *d, size_t node);
+lept_uint64 lept_ondemand_get_uint64        (lept_ondemand *d, size_t node);
+const char* lept_ondemand_get_string        (lept_ondemand *d, size_t node);
+size_t      lept_ondemand_get_string_length (lept_ondemand *d, size_t node);
+size_t      lept_ondemand_get_array_size    (lept_ondemand *d, size_t node);
+size_t      lept_ondemand_get_array_element (lept_ondemand *d, size_t node, size_t index);
+size_t      lept_ondemand_get_object_size   (lept_ondemand *d, size_t node);
+const char* lept_ondemand_get_object_key    (lept_ondemand *d, size_t node, size_t index);
+size_t      lept_ondemand_get_object_key_length(lept_ondemand *d, size_t node, size_t index);
+size_t      lept_ondemand_get_object_value  (lept_ondemand *d, size_t node, size_t index);
+size_t      lept_ondemand_get_object_value_by_key(lept_ondemand *d, size_t node, const char *k, size_t klen);
+
+/*
+ * reader: a pull tokenizer. Each lept_reader_next() returns the next token
+ * under the rules of lept_parse(); after LEPT_TOKEN_END or LEPT_TOKEN_ERROR
+ * it keeps returning the same. A string or key (not '\0'-terminated) and a
+ * scalar value stay valid until the next call; a string without escapes
+ * points into json and costs no allocation. lept_reader_get_size() gives
+ * the elements or members of a container at its end token. Stopping early
+ * is fine; lept_reader_free() releases what the reader holds.
+ */
+typedef enum {
+    LEPT_TOKEN_NULL, LEPT_TOKEN_FALSE, LEPT_TOKEN_TRUE, LEPT_TOKEN_NUMBER, LEPT_TOKEN_STRING, LEPT_TOKEN_KEY,
+    LEPT_TOKEN_START_ARRAY, LEPT_TOKEN_END_ARRAY, LEPT_TOKEN_START_OBJECT, LEPT_TOKEN_END_OBJECT,
+    LEPT_TOKEN_END, LEPT_TOKEN_ERROR
+} lept_token;
+
+typedef struct {
+    const char* json;       /* internal */
+    char* stack;            /* internal */
+    size_t size, top;       /* internal */
+    size_t depth;           /* internal */
+    int state, error;       /* internal */
+    lept_value v;           /* internal: the current scalar */
+    const char* s;          /* internal: the current string or key */
+    size_t len, count;      /* internal */
+    const lept_allocator* allocator;    /* internal */
+}lept_reader;
+
+void        lept_reader_init  (lept_reader *r, const char *json);
+void        lept_reader_set_allocator(lept_reader *r, const lept_allocator *a);   /* before the first token */
+lept_token  lept_reader_next  (lept_reader *r);
+void        lept_reader_free  (lept_reader *r);
+int         lept_reader_get_error          (const lept_reader *r);
+const lept_value* lept_reader_get_value    (const lept_reader *r);  /* null, boolean or number */
+const char* lept_reader_get_string         (const lept_reader *r);
+size_t      lept_reader_get_string_length  (const lept_reader *r);
+size_t      lept_reader_get_size           (const lept_reader *r);
+
+/*
+ * sax: lept_parse_sax() hands each token of a reader to a handler instead
+ * of building a tree, in constant memory apart from the nesting and the
+ * longest escaped string. Strings and keys are not '\0'-terminated and are
+ * only valid during the call; numbers come as a LEPT_NUMBER or LEPT_INTEGER
+ * value to read with lept_get_number() and friends. A NULL callback ignores
+ * its event; a callback returning 0 stops the parse with
+ * LEPT_PARSE_CANCELLED.
+ */
+typedef struct {
+    int (*null)         (void *user);
+    int (*boolean)      (void *user, int b);
+    int (*number)       (void *user, const lept_value *v);
+    int (*string)       (void *user, const char *s, size_t len);
+    int (*start_object) (void *user);
+    int (*key)          (void *user, const char *k, size_t len);
+    int (*end_object)   (void *user, size_t size);
+    int (*start_array)  (void *user);
+    int (*end_array)    (void *user, size_t size);
+    void* user;
+}lept_sax_handler;
+
+int lept_parse_sax(const char *json, const lept_sax_handler *h);
+
+/*
+ * stream: builds the tree of lept_parse() from chunks as they arrive. A
+ * chunk may end anywhere, even inside a string, an escape or a number; the
+ * stream keeps only the unfinished token and the containers still open.
+ * lept_stream_feed() returns LEPT_PARSE_OK while the input so far can start
+ * a document, or the error once the token at fault is complete, and keeps
+ * returning it. lept_stream_finish() ends the input, returns what
+ * lept_parse() would return for the whole of it, moves the tree into v on
+ * success and releases the stream; lept_stream_free() drops it unfinished.
+ * The buffer, the stack and the tree come from the stream's allocator.
+ */
+typedef struct {
+    lept_reader r;          /* internal: the tokenizer between chunks */
+    char* buf;              /* internal: the unconsumed input, '\0'-terminated */
+    size_t pos, len, cap;   /* internal */
+    char* stack;            /* internal: the open containers */
+    size_t size, top, frame;/* internal */
+    size_t held;            /* internal: how far the step at pos is scanned, */
+    int hold;               /* internal: and in what, while undecided */
+    lept_value v;           /* internal: the root once complete */
+    int error;              /* internal */
+}lept_stream;
+
+void lept_stream_init  (lept_stream *s);
+void lept_stream_set_allocator(lept_stream *s, const lept_allocator *a);   /* before the first chunk */
+int  lept_stream_feed  (lept_stream *s, const char *chunk, size_t len);
+int  lept_stream_finish(lept_stream *s, lept_value *v);
+void lept_stream_free  (lept_stream *s);
+
+/*
+ * ndjson: parses newline-delimited JSON, one document per line, with
+ * threads worker threads (0 or 1: on the calling thread), each reusing its
+ * own parser. record() is called on the calling thread for every line that
+ * is not blank, in input order, with its 0-based line number and what
+ * lept_parse() returns for it; the tree in v is then the callback's to
+ * free. A callback returning 0 stops the parse with LEPT_PARSE_CANCELLED.
+ */
+typedef int (*lept_ndjson_record)(void *user, size_t line, lept_value *v, int ret);
+
+int lept_parse_ndjson(const char *json, size_t len, size_t threads, lept_ndjson_record record, void *user);
+
+/*
+ * parallel: parses json as lept_parse_n() does, but the elements of a root
+ * array are parsed on threads worker threads (0 or 1: on the calling
+ * thread) and kept in input order. A first pass finds where they start by
+ * skipping over them, counting brackets and following strings. A root of
+ * another type is parsed on the calling thread.
+ */
+int lept_parse_parallel(lept_value *v, const char *json, size_t len, size_t threads);
 
 void lept_free(lept_value *v);
+void lept_free_ex(lept_value *v, const lept_allocator *a);
 
 lept_type lept_get_type(const lept_value *v);
 
@@ -59,14 +403,25 @@ lept_type lept_get_type(const lept_value *v);
 int     lept_get_boolean    (const lept_value *v);
 void    lept_set_boolean    (lept_value *v, int b);
 
-/* number */
+/*
+ * number: also reads a LEPT_INTEGER, converted to double. A lazy number
+ * (LEPT_PARSE_FLAG_LAZY_NUMBER) is not cached: each call parses its literal
+ * again.
+ */
 double  lept_get_number (const lept_value *v);
 void    lept_set_number (lept_value *v, double n);
 
+/* integer */
+lept_int64  lept_get_int64  (const lept_value *v);
+void        lept_set_int64  (lept_value *v, lept_int64 i);
+lept_uint64 lept_get_uint64 (const lept_value *v);
+void        lept_set_uint64 (lept_value *v, lept_uint64 u);
+
 /* string */
 const char* lept_get_string         (const lept_value *v);
 size_t      lept_get_string_length  (const lept_value *v);
 void        lept_set_string         (lept_value *v, const char *s, size_t len);
+void        lept_set_string_ex      (lept_value *v, const char *s, size_t len, const lept_allocator *a);
 
 /* array */
 size_t          lept_get_array_size(const lept_value* v);
@@ -79,7 +434,23 @@ size_t       lept_get_object_key_length (const lept_value* v, size_t index);
 lept_value*  lept_get_object_value      (const lept_value* v, size_t index);
 lept_value*  lept_get_object_value_by_key(const lept_value* v, const char* k, size_t klen);
 
-/* stringify */
+/* stringify: *json is released with free(), or with a's free for lept_stringify_ex() */
 int lept_stringify(const lept_value* v, char** json, size_t* length);
+int lept_stringify_ex(const lept_value* v, char** json, size_t* length, const lept_allocator* a);
+
+/*
+ * simd: kernels are picked at runtime from what the CPU supports, once: when
+ * the library is loaded with GCC or Clang, else on first use, which threads
+ * may reach together where pthreads are available. lept_set_simd() swaps the
+ * kernels in place: call it before other threads parse, never while they do.
+ */
+enum {
+    LEPT_SIMD_NONE = 0,     /* scalar reference code */
+    LEPT_SIMD_SSE2,
+    LEPT_SIMD_AVX2
+};
+
+int lept_get_simd(void);
+int lept_set_simd(int level); /* clamps to the CPU, returns the level in use */
 
 #endif  /* LEPTJSON_H__ */
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <locale.h>
 #include "leptjson.h"
 
 static int main_ret = 0;
@@ -32,6 +33,32 @@ static int test_pass = 0;
 #define EXPECT_EQ_SIZE_T(expect, actual) EXPECT_EQ_BASE((expect) == (actual), (size_t)expect, (size_t)actual, "%zu")
 #endif
 
+/* C90 printf has no 64-bit length modifier: 64-bit values print as two 32-bit hex halves */
+#define EXPECT_EQ_BASE64(equality, expect, actual) \
+    do {\
+        test_count++;\
+        if (equality){\
+            test_pass++;\
+        }else{\
+            fprintf(stderr, "%s:%d expect: 0x%08lx%08lx actual: 0x%08lx%08lx\n", __FILE__, __LINE__,\
+                (unsigned long)((lept_uint64)(expect) >> 32), (unsigned long)((lept_uint64)(expect) & 0xFFFFFFFFUL),\
+                (unsigned long)((lept_uint64)(actual) >> 32), (unsigned long)((lept_uint64)(actual) & 0xFFFFFFFFUL));\
+            main_ret = 1;\
+        }\
+    }while(0)
+
+#define EXPECT_EQ_INT64(expect, actual) EXPECT_EQ_BASE64((lept_int64)(expect) == (lept_int64)(actual), expect, actual)
+#define EXPECT_EQ_UINT64(expect, actual) EXPECT_EQ_BASE64((lept_uint64)(expect) == (lept_uint64)(actual), expect, actual)
+
+#define TEST_INTEGER(expect, json) \
+    do { \
+        lept_value v; \
+        lept_init(&v); \
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json)); \
+        EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v)); \
+        EXPECT_EQ_INT64(expect, lept_get_int64(&v)); \
+    }while(0)
+
 #define TEST_NUMBER(expect, json) \
     do { \
         lept_value v; \
@@ -46,6 +73,9 @@ static int test_pass = 0;
         v.type = LEPT_FALSE; \
         EXPECT_EQ_INT(error, lept_parse(&v, json)); \
         EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v)); \
+        v.type = LEPT_FALSE; \
+        EXPECT_EQ_INT(error, lept_parse_ex(&v, json, LEPT_PARSE_FLAG_INDEXED, NULL)); \
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v)); \
     }while(0)
 
 #define TEST_STRING(expect, json) \
@@ -69,16 +99,32 @@ static int test_pass = 0;
         EXPECT_EQ_STRING(json, json2, length); \
         lept_free(&v); \
         free(json2); \
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, LEPT_PARSE_FLAG_INDEXED, NULL)); \
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json2, &length)); \
+        EXPECT_EQ_STRING(json, json2, length); \
+        lept_free(&v); \
+        free(json2); \
     } while(0) 
+
+/* two trees stringify the same */
+static void test_expect_same_tree(const lept_value* v1, const lept_value* v2) {
+    char *s1, *s2;
+    size_t n1, n2;
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(v1, &s1, &n1));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(v2, &s2, &n2));
+    EXPECT_TRUE(n1 == n2 && memcmp(s1, s2, n1) == 0);
+    free(s1);
+    free(s2);
+}
         
 
 static void test_parse_number() {
-    TEST_NUMBER(123.0, "123");
-    TEST_NUMBER(0.0, "0");
+    TEST_INTEGER(123, "123");
+    TEST_INTEGER(0, "0");
     TEST_NUMBER(0.0, "-0");
     TEST_NUMBER(0.0, "-0.0");
-    TEST_NUMBER(1.0, "1");
-    TEST_NUMBER(-1.0, "-1");
+    TEST_INTEGER(1, "1");
+    TEST_INTEGER(-1, "-1");
     TEST_NUMBER(1.5, "1.5");
     TEST_NUMBER(-1.5, "-1.5");
     TEST_NUMBER(3.1416, "3.1416");
@@ -93,6 +139,94 @@ static void test_parse_number() {
     TEST_NUMBER(1.234E+10, "1.234E+10");
     TEST_NUMBER(1.234E-10, "1.234E-10");
     TEST_NUMBER(0.0, "1e-10000"); /* must underflow */
+
+    /* boundary cases for the fast paths */
+    TEST_NUMBER(1.0000000000000002, "1.0000000000000002"); /* the smallest number > 1 */
+    TEST_NUMBER( 4.9406564584124654e-324, "4.9406564584124654e-324"); /* minimum denormal */
+    TEST_NUMBER(-4.9406564584124654e-324, "-4.9406564584124654e-324");
+    TEST_NUMBER( 2.2250738585072009e-308, "2.2250738585072009e-308");  /* max subnormal double */
+    TEST_NUMBER(-2.2250738585072009e-308, "-2.2250738585072009e-308");
+    TEST_NUMBER( 2.2250738585072014e-308, "2.2250738585072014e-308");  /* min normal positive double */
+    TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
+    TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* max double */
+    TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(9007199254740992.0, "9007199254740993.0"); /* halfway: round to even */
+    TEST_NUMBER(0.1, "0.1000000000000000055511151231257827021181583404541015625");
+    TEST_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+    TEST_NUMBER(1e-5, "0.00000000000000000000000000000000000000000001e39");
+}
+
+static void test_parse_integer() {
+    lept_value v;
+    TEST_INTEGER(1234567890123456789, "1234567890123456789");
+    TEST_INTEGER(-1234567890123456789, "-1234567890123456789");
+    TEST_INTEGER(9007199254740993, "9007199254740993"); /* not representable as double */
+    TEST_INTEGER(9223372036854775807, "9223372036854775807"); /* INT64_MAX */
+    TEST_INTEGER(-9223372036854775807 - 1, "-9223372036854775808"); /* INT64_MIN */
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551615")); /* UINT64_MAX */
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_EQ_UINT64(18446744073709551615u, lept_get_uint64(&v));
+    EXPECT_EQ_DOUBLE(18446744073709551615.0, lept_get_number(&v));
+    lept_free(&v);
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "9223372036854775808")); /* INT64_MAX + 1 */
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_EQ_UINT64(9223372036854775808u, lept_get_uint64(&v));
+    lept_free(&v);
+
+    /* out of range or not integral: double */
+    TEST_NUMBER(18446744073709551616.0, "18446744073709551616");
+    TEST_NUMBER(-9223372036854775809.0, "-9223372036854775809");
+    TEST_NUMBER(100000000000000000000.0, "100000000000000000000");
+    TEST_NUMBER(1.0, "1.0");
+    TEST_NUMBER(10.0, "1e1");
+}
+
+#define TEST_LAZY_NUMBER(expect, json) \
+    do { \
+        lept_value v; \
+        char* json2; \
+        size_t length; \
+        lept_init(&v); \
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, LEPT_PARSE_FLAG_LAZY_NUMBER, NULL)); \
+        EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v)); \
+        EXPECT_EQ_DOUBLE(expect, lept_get_number(&v)); \
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json2, &length)); \
+        EXPECT_EQ_STRING(json, json2, length); \
+        free(json2); \
+        lept_free(&v); \
+    }while(0)
+
+static void test_parse_lazy_number() {
+    lept_value v;
+    TEST_LAZY_NUMBER(1.5, "1.5");
+    TEST_LAZY_NUMBER(1.5, "1.50");
+    TEST_LAZY_NUMBER(-0.0, "-0");
+    TEST_LAZY_NUMBER(1.23e20, "1.23e+20");
+    TEST_LAZY_NUMBER(1E-10, "1E-10");
+    TEST_LAZY_NUMBER(0.0, "1e-10000");
+    TEST_LAZY_NUMBER(1.7976931348623157e+308, "1.7976931348623157e+308");
+    TEST_LAZY_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+
+    /* overflow is still reported at parse time */
+    v.type = LEPT_FALSE;
+    EXPECT_EQ_INT(LEPT_PARSE_NUMBER_TOO_BIG, lept_parse_ex(&v, "1.8e308", LEPT_PARSE_FLAG_LAZY_NUMBER, NULL));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_NUMBER_TOO_BIG, lept_parse_ex(&v, "-1e309", LEPT_PARSE_FLAG_LAZY_NUMBER, NULL));
+
+    /* integers are exact already */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "[12, 1.0e0]", LEPT_PARSE_FLAG_LAZY_NUMBER, NULL));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_array_element(&v, 0)));
+    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_array_element(&v, 1)));
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(&v, 1)));
+    lept_set_number(lept_get_array_element(&v, 1), 2.5);
+    EXPECT_EQ_DOUBLE(2.5, lept_get_number(lept_get_array_element(&v, 1)));
+    lept_free(&v);
 }
 
 static void test_parse_null() {
@@ -139,6 +273,52 @@ static void test_parse_invalid_value() {
 #endif
 }
 
+/* literals are matched a word at a time: every corruption, prefix and placement across a page */
+static void test_parse_literal_word() {
+    static const char* const literals[] = { "null", "true", "false" };
+    static const lept_type types[] = { LEPT_NULL, LEPT_TRUE, LEPT_FALSE };
+    char json[16], *buf, *page, *s;
+    lept_value v;
+    size_t i, j, len, off;
+    int ch;
+    for (i = 0; i < 3; i++) {
+        len = strlen(literals[i]);
+        for (j = 1; j < len; j++) {
+            for (ch = 1; ch < 256; ch++) {
+                if (ch != (unsigned char)literals[i][j]) {
+                    strcpy(json, literals[i]);
+                    json[j] = (char)ch;
+                    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, json);
+                }
+            }
+            s = (char*)malloc(j + 1);   /* exact fit */
+            memcpy(s, literals[i], j);
+            s[j] = '\0';
+            TEST_ERROR(LEPT_PARSE_INVALID_VALUE, s);
+            free(s);
+        }
+    }
+
+    buf = (char*)malloc(3 * 4096);
+    page = buf + 4096 * 2 - ((size_t)buf & 4095);
+    for (i = 0; i < 3; i++) {
+        len = strlen(literals[i]);
+        for (off = 0; off <= len + 1; off++) {
+            s = page - off;
+            s[-1] = '[';
+            strcpy(s, literals[i]);
+            strcpy(s + len, "]");
+            lept_init(&v);
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, s - 1));
+            EXPECT_EQ_INT(types[i], lept_get_type(lept_get_array_element(&v, 0)));
+            lept_free(&v);
+            s[len - 1] = 'x';
+            TEST_ERROR(LEPT_PARSE_INVALID_VALUE, s - 1);
+        }
+    }
+    free(buf);
+}
+
 static void test_parse_root_not_singular() {
     TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "null x");
 
@@ -173,6 +353,20 @@ static void test_access_number() {
     EXPECT_EQ_DOUBLE(0.0, lept_get_number(&v));
     lept_free(&v);
 }
+static void test_access_integer() {
+    lept_value v;
+    lept_init(&v);
+    lept_set_string(&v, "a", 1);
+    lept_set_int64(&v, -1234567890123456789);
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_EQ_INT64(-1234567890123456789, lept_get_int64(&v));
+    lept_set_uint64(&v, 18446744073709551615u);
+    EXPECT_EQ_UINT64(18446744073709551615u, lept_get_uint64(&v));
+    lept_set_int64(&v, 42);
+    EXPECT_EQ_UINT64(42, lept_get_uint64(&v));
+    EXPECT_EQ_DOUBLE(42.0, lept_get_number(&v));
+    lept_free(&v);
+}
 static void test_access_string() {
     lept_value v;
     lept_init(&v);
@@ -211,6 +405,201 @@ static void test_parse_string() {
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
 }
 
+static void test_parse_insitu() {
+    char json[] = "{ \"k\\u0041y\" : [ \"a\\nb\", \"\", \"\\uD834\\uDD1E\\t\", 1.5 ], \"x\": \"plain\" }";
+    char bad[] = "[\"ok\", \"\\x\"]";
+    lept_value v, *a;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, json));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_STRING("kAy", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    EXPECT_EQ_INT('\0', lept_get_object_key(&v, 0)[3]);
+    EXPECT_TRUE(lept_get_object_key(&v, 0) >= json && lept_get_object_key(&v, 0) < json + sizeof(json));
+    a = lept_get_object_value(&v, 0);
+    EXPECT_EQ_SIZE_T(4, lept_get_array_size(a));
+    EXPECT_EQ_STRING("a\nb", lept_get_string(lept_get_array_element(a, 0)), lept_get_string_length(lept_get_array_element(a, 0)));
+    EXPECT_EQ_STRING("", lept_get_string(lept_get_array_element(a, 1)), lept_get_string_length(lept_get_array_element(a, 1)));
+    EXPECT_EQ_STRING("\xF0\x9D\x84\x9E\t", lept_get_string(lept_get_array_element(a, 2)), lept_get_string_length(lept_get_array_element(a, 2)));
+    EXPECT_EQ_DOUBLE(1.5, lept_get_number(lept_get_array_element(a, 3)));
+    EXPECT_EQ_STRING("plain", lept_get_string(lept_get_object_value_by_key(&v, "x", 1)), 5);
+    EXPECT_TRUE(lept_get_string(lept_get_object_value(&v, 1)) > json && lept_get_string(lept_get_object_value(&v, 1)) < json + sizeof(json));
+    /* a borrowed string can be replaced by an owned one */
+    lept_set_string(lept_get_array_element(a, 0), "owned", 5);
+    EXPECT_EQ_STRING("owned", lept_get_string(lept_get_array_element(a, 0)), 5);
+    lept_free(&v);
+
+    v.type = LEPT_FALSE;
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_parse_insitu(&v, bad));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_parse_document() {
+    lept_document d;
+    lept_value* a;
+    size_t i;
+    char json[64 * 32 + 16], *p = json;
+
+    lept_document_init(&d);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, "{\"k\":[\"abc\",1,{\"x\\u0000y\":null}],\"s\":\"\"}", 0));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&d.root));
+    EXPECT_EQ_SIZE_T(2, lept_get_object_size(&d.root));
+    a = lept_get_object_value_by_key(&d.root, "k", 1);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(a));
+    EXPECT_EQ_STRING("abc", lept_get_string(lept_get_array_element(a, 0)), lept_get_string_length(lept_get_array_element(a, 0)));
+    EXPECT_EQ_INT64(1, lept_get_int64(lept_get_array_element(a, 1)));
+    EXPECT_EQ_STRING("x\0y", lept_get_object_key(lept_get_array_element(a, 2), 0), lept_get_object_key_length(lept_get_array_element(a, 2), 0));
+    EXPECT_EQ_STRING("", lept_get_string(lept_get_object_value(&d.root, 1)), 0);
+
+    /* reparse into the retained block, spilling into new ones */
+    p += sprintf(p, "[");
+    for (i = 0; i < 64; i++) {
+        p += sprintf(p, "%s\"str%03u\"", i ? "," : "", (unsigned)i);
+    }
+    sprintf(p, "]");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, json, 0));
+    EXPECT_EQ_SIZE_T(64, lept_get_array_size(&d.root));
+    EXPECT_EQ_STRING("str063", lept_get_string(lept_get_array_element(&d.root, 63)), 6);
+
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_document_parse(&d, "{\"a\":[\"b\"]", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&d.root));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_document_parse(&d, "[\"b\"] x", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&d.root));
+    lept_document_reset(&d);
+    lept_document_free(&d);
+}
+
+typedef struct {
+    int allocs, frees;
+} test_alloc_count;
+
+static void* test_alloc(void* user, size_t size) {
+    ((test_alloc_count*)user)->allocs++;
+    return malloc(size);
+}
+static void* test_realloc(void* user, void* ptr, size_t size) {
+    if (ptr == NULL) {
+        ((test_alloc_count*)user)->allocs++;
+    }
+    return realloc(ptr, size);
+}
+static void test_free(void* user, void* ptr) {
+    ((test_alloc_count*)user)->frees++;
+    free(ptr);
+}
+
+static void test_parse_allocator() {
+    test_alloc_count count = { 0, 0 }, other = { 0, 0 }, doc_count = { 0, 0 };
+    lept_allocator a, b, d_a;
+    lept_document d;
+    lept_parser p;
+    lept_stream st;
+    lept_value v, w;
+    char* json;
+    a.alloc = test_alloc; a.realloc = test_realloc; a.free = test_free; a.user = &count;
+    b = a; b.user = &other;
+    d_a = a; d_a.user = &doc_count;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "{\"a\":[\"x\",\"y\"],\"b\":{\"c\":\"z\"}}", 0, &a));
+    EXPECT_TRUE(count.allocs > 0);
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_ex(&v, &json, NULL, &a));
+    a.free(a.user, json);
+    lept_set_string_ex(&v, "s", 1, &a);
+    lept_free_ex(&v, &a);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_ex(&v, "[\"x\", {\"k\": \"v\"} \"y\"]", 0, &a));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_ex(&v, "[\"x\", {\"k\": \"v\"}] x", 0, &a));
+    lept_free_ex(&v, &a);
+    EXPECT_EQ_INT(count.allocs, count.frees);
+
+    /* trees side by side, each with its own allocator */
+    count.allocs = count.frees = 0;
+    lept_init(&w);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "[\"x\", {\"k\": \"v\"}]", 0, &a));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&w, "[\"y\"]", 0, &b));
+    lept_free_ex(&v, &a);
+    lept_free_ex(&w, &b);
+    EXPECT_TRUE(count.allocs > 0 && other.allocs > 0);
+    EXPECT_EQ_INT(count.allocs, count.frees);
+    EXPECT_EQ_INT(other.allocs, other.frees);
+
+    /* a parser: its stack and its trees */
+    count.allocs = count.frees = 0;
+    lept_parser_init(&p);
+    lept_parser_set_allocator(&p, &a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, "{\"k\": [\"v\"]}", 0));
+    lept_free_ex(&v, &a);
+    lept_parser_free(&p);
+    EXPECT_TRUE(count.allocs > 0);
+    EXPECT_EQ_INT(count.allocs, count.frees);
+
+    /* a stream: its buffer, its stack and the tree */
+    count.allocs = count.frees = 0;
+    lept_stream_init(&st);
+    lept_stream_set_allocator(&st, &a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&st, "[\"x\", {\"k", 9));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&st, "\": \"v\"}]", 8));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_finish(&st, &v));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v));
+    lept_free_ex(&v, &a);
+    EXPECT_TRUE(count.allocs > 0);
+    EXPECT_EQ_INT(count.allocs, count.frees);
+
+    /* a document has its own allocator */
+    count.allocs = count.frees = 0;
+    lept_document_init(&d);
+    lept_document_set_allocator(&d, &d_a);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, "[\"a\", \"b\", {\"c\": 1}]", 0));
+    lept_document_free(&d);
+    EXPECT_EQ_INT(0, count.allocs);
+    EXPECT_TRUE(doc_count.allocs > 0);
+    EXPECT_EQ_INT(doc_count.allocs, doc_count.frees);
+}
+
+static void test_parse_parser() {
+    lept_parser p;
+    lept_value v;
+    char* json;
+    size_t i, size;
+    char buf[4096], *q = buf;
+
+    q += sprintf(q, "[");
+    for (i = 0; i < 100; i++) {
+        q += sprintf(q, "%s{\"id\":%u,\"name\":\"item %u\"}", i ? "," : "", (unsigned)i, (unsigned)i);
+    }
+    sprintf(q, "]");
+
+    lept_parser_init(&p);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, buf, 0));
+    EXPECT_EQ_SIZE_T(100, lept_get_array_size(&v));
+    EXPECT_EQ_INT64(99, lept_get_int64(lept_get_object_value_by_key(lept_get_array_element(&v, 99), "id", 2)));
+    lept_free(&v);
+    size = p.size;
+    EXPECT_TRUE(size > 0);
+
+    /* the warmed-up stack is reused as is */
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, buf, 0));
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json, NULL));
+        EXPECT_TRUE(strcmp(buf, json) == 0);
+        free(json);
+        lept_free(&v);
+        EXPECT_EQ_SIZE_T(size, p.size);
+    }
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parser_parse(&p, &v, "[1, 2", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* capped: a stack above the cap is not kept */
+    lept_parser_set_max_retained(&p, 1024);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, buf, 0));
+    lept_free(&v);
+    EXPECT_EQ_SIZE_T(0, p.size);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, "[\"small\"]", 0));
+    lept_free(&v);
+    EXPECT_TRUE(p.size > 0 && p.size <= 1024);
+    lept_parser_free(&p);
+}
+
 static void test_parse_invalid_string_escape() {
 #if 1
     TEST_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE, "\"\\v\"");
@@ -248,6 +637,9 @@ static void test_parse_invalid_unicode_surrogate() {
     TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\\\\"");
     TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\uDBFF\"");
     TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\uE000\"");
+    TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDC00\"");
+    TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDFFF\"");
+    TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDC00\\uD800\"");
 }
 
 static void test_parse_array() {
@@ -320,7 +712,7 @@ static void test_parse_array() {
     EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(pt));
     EXPECT_EQ_SIZE_T(3, lept_get_array_size(pt));
     for(i = 0; i < 3 ; i++){
-        EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_array_element(pt, i)));
+        EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_array_element(pt, i)));
         EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(pt, i)));
     }
     lept_free(&v);
@@ -357,7 +749,7 @@ static void test_parse_object() {
     EXPECT_EQ_STRING("t", lept_get_object_key(&v, 2), lept_get_object_key_length(&v, 2));
     EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_object_value(&v, 2)));
     EXPECT_EQ_STRING("i", lept_get_object_key(&v, 3), lept_get_object_key_length(&v, 3));
-    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_object_value(&v, 3)));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_object_value(&v, 3)));
     EXPECT_EQ_DOUBLE(123.0, lept_get_number(lept_get_object_value(&v, 3)));
     EXPECT_EQ_STRING("s", lept_get_object_key(&v, 4), lept_get_object_key_length(&v, 4));
     EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_object_value(&v, 4)));
@@ -366,7 +758,7 @@ static void test_parse_object() {
     EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_object_value_by_key(&v, "n", 1)));
     EXPECT_EQ_INT(LEPT_FALSE, lept_get_type(lept_get_object_value_by_key(&v, "f", 1)));
     EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_object_value_by_key(&v, "t", 1)));
-    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_object_value_by_key(&v, "i", 1)));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_object_value_by_key(&v, "i", 1)));
     EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_object_value_by_key(&v, "s", 1)));
     EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(lept_get_object_value_by_key(&v, "a", 1)));
     EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(lept_get_object_value_by_key(&v, "o", 1)));
@@ -409,17 +801,1564 @@ static void test_parse_miss_comma_or_curly_bracket() {
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
 }
 
+static void test_parse_too_deep() {
+    lept_parser p;
+    lept_value v;
+    const lept_value* e;
+    size_t i, len, n = 100000;
+    char* json = (char*)malloc(n * 2 + 1);
+    char *s, *q;
+
+    /* exactly at the limit */
+    for (i = 0; i < LEPT_PARSE_MAX_DEPTH; i++) {
+        json[i] = '[';
+        json[LEPT_PARSE_MAX_DEPTH * 2 - 1 - i] = ']';
+    }
+    json[LEPT_PARSE_MAX_DEPTH * 2] = '\0';
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    for (e = &v, i = 1; i < LEPT_PARSE_MAX_DEPTH; i++) {
+        EXPECT_EQ_SIZE_T(1, lept_get_array_size(e));
+        e = lept_get_array_element(e, 0);
+    }
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(e));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(e));
+    lept_free(&v);
+
+    /* one past it */
+    memmove(json + 5, json, LEPT_PARSE_MAX_DEPTH * 2 + 1);
+    json[0] = '{';
+    memcpy(json + 1, "\"a\":", 4);
+    json[LEPT_PARSE_MAX_DEPTH * 2 + 5] = '}';
+    json[LEPT_PARSE_MAX_DEPTH * 2 + 6] = '\0';
+    v.type = LEPT_FALSE;
+    EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse(&v, json));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* far beyond any call stack */
+    memset(json, '[', n);
+    json[n] = '\0';
+    TEST_ERROR(LEPT_PARSE_TOO_DEEP, json);
+
+    /* an unlimited parser closes them all, and the tree is written and freed without recursion */
+    memset(json + n, ']', n);
+    json[n * 2] = '\0';
+    lept_parser_init(&p);
+    lept_parser_set_max_depth(&p, 0);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, json, 0));
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &s, &len));
+    EXPECT_TRUE(len == n * 2 && memcmp(s, json, len) == 0);
+    free(s);
+    lept_free(&v);
+    json[n * 2 - 1] = '\0';
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parser_parse(&p, &v, json, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    for (q = json, i = 0; i < n / 10; i++) {
+        q += strlen(strcpy(q, "{\"k\":[\"s\","));
+    }
+    *q++ = '0';
+    for (i = 0; i < n / 10; i++) {
+        q += strlen(strcpy(q, "]}"));
+    }
+    *q = '\0';
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, json, 0));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &s, &len));
+    EXPECT_TRUE(len == (size_t)(q - json) && memcmp(s, json, len) == 0);
+    free(s);
+    lept_free(&v);
+    lept_parser_set_max_depth(&p, 2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parser_parse(&p, &v, "[{\"a\":1}]", 0));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parser_parse(&p, &v, "[{\"a\":[1]}]", 0));
+    lept_parser_free(&p);
+    free(json);
+
+    /* errors deep inside free everything parsed so far */
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "[\"x\",{\"a\":[\"y\",{\"b\":\"z\"}] \"c\"}]");
+    TEST_ERROR(LEPT_PARSE_MISS_COLON, "{\"a\":[{\"b\":\"c\",\"d\"}]}");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "[[\"s\",[\"t\",nul]]]");
+}
+
+static int test_parse_whitespace_run(char* buf, size_t run, const char* tail) {
+    static const char ws[] = " \t\r\n";
+    lept_value v;
+    size_t i;
+    int ret;
+    for (i = 0; i < run; i++) {
+        buf[i] = ws[i % 4];
+    }
+    strcpy(buf + run, tail);
+    lept_init(&v);
+    ret = lept_parse(&v, buf);
+    lept_free(&v);
+    return ret;
+}
+
+/* every SIMD level must agree with the scalar reference on every run length and alignment */
+static void test_parse_whitespace_simd() {
+    static char buf[256];
+    int level, max, ret;
+    size_t run, off;
+    max = lept_set_simd(LEPT_SIMD_AVX2);
+    for (level = LEPT_SIMD_NONE; level <= max; level++) {
+        EXPECT_EQ_INT(level, lept_set_simd(level));
+        for (off = 0; off < 32; off++) {
+            for (run = 0; run < 80; run++) {
+                ret = test_parse_whitespace_run(buf + off, run, "[ \n\t null ,\r\n  true  ]   ");
+                EXPECT_EQ_INT(LEPT_PARSE_OK, ret);
+                ret = test_parse_whitespace_run(buf + off, run, "null                                     x");
+                EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, ret);
+                ret = test_parse_whitespace_run(buf + off, run, "");
+                EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, ret);
+            }
+        }
+    }
+    lept_set_simd(max);
+}
+
+/* strings long enough to take several SIMD blocks, with the special byte at every offset */
+static void test_parse_string_simd() {
+    static char buf[256];
+    lept_value v;
+    int level, max;
+    size_t len, off, i;
+    max = lept_set_simd(LEPT_SIMD_AVX2);
+    for (level = LEPT_SIMD_NONE; level <= max; level++) {
+        EXPECT_EQ_INT(level, lept_set_simd(level));
+        for (off = 0; off < 32; off++) {
+            for (len = 0; len < 80; len++) {
+                char* s = buf + off;
+                s[0] = '\"';
+                for (i = 0; i < len; i++) {
+                    s[i + 1] = (char)('a' + i % 26);
+                }
+                strcpy(s + len + 1, "\\n\"");
+                lept_init(&v);
+                EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, s));
+                EXPECT_EQ_SIZE_T(len + 1, lept_get_string_length(&v));
+                EXPECT_TRUE(memcmp(s + 1, lept_get_string(&v), len) == 0);
+                EXPECT_EQ_INT('\n', lept_get_string(&v)[len]);
+                lept_free(&v);
+
+                s[len + 1] = '\x01';
+                s[len + 2] = '\"';
+                s[len + 3] = '\0';
+                TEST_ERROR(LEPT_PARSE_INVALID_STRING_CHAR, s);
+                s[len + 1] = '\0';
+                TEST_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, s);
+            }
+        }
+    }
+    lept_set_simd(max);
+}
+
+/* random documents: whitespace, escapes and token boundaries land anywhere */
+static unsigned long test_seed = 1;
+
+static unsigned test_rand(unsigned n) {
+    test_seed = test_seed * 1103515245 + 12345;
+    return (unsigned)((test_seed >> 16) & 0x7FFF) % n;
+}
+
+static char* test_gen_space(char* q) {
+    static const char ws[] = " \t\r\n";
+    unsigned i, n = test_rand(4) == 0 ? test_rand(70) : test_rand(2);
+    for (i = 0; i < n; i++) {
+        *q++ = ws[test_rand(4)];
+    }
+    return q;
+}
+
+static char* test_gen_string(char* q) {
+    static const char* const pieces[] = {
+        "a", "bc", "\\\\", "\\\"", "\\n", "\\u00e9", "\\uD834\\uDD1E", "\\\\\\\"", "{[:,]}", " "
+    };
+    unsigned i, n = test_rand(4) == 0 ? test_rand(80) : test_rand(6);
+    *q++ = '\"';
+    for (i = 0; i < n; i++) {
+        const char* s = pieces[test_rand(sizeof(pieces) / sizeof(pieces[0]))];
+        q += strlen(strcpy(q, s));
+    }
+    *q++ = '\"';
+    return q;
+}
+
+static char* test_gen_value(char* q, int depth) {
+    static const char* const scalars[] = { "null", "true", "false", "0", "-12", "3.25e-3", "18446744073709551615", "1E2" };
+    unsigned i, n;
+    switch (depth > 6 ? test_rand(2) : test_rand(4)) {
+        case 0:
+            q += strlen(strcpy(q, scalars[test_rand(sizeof(scalars) / sizeof(scalars[0]))]));
+            break;
+        case 1:
+            q = test_gen_string(q);
+            break;
+        case 2:
+            *q++ = '[';
+            n = test_rand(5);
+            for (i = 0; i < n; i++) {
+                q = test_gen_space(q);
+                q = test_gen_value(q, depth + 1);
+                q = test_gen_space(q);
+                if (i + 1 < n) {
+                    *q++ = ',';
+                }
+            }
+            *q++ = ']';
+            break;
+        default:
+            *q++ = '{';
+            n = test_rand(5);
+            for (i = 0; i < n; i++) {
+                q = test_gen_space(q);
+                q = test_gen_string(q);
+                q = test_gen_space(q);
+                *q++ = ':';
+                q = test_gen_space(q);
+                q = test_gen_value(q, depth + 1);
+                q = test_gen_space(q);
+                if (i + 1 < n) {
+                    *q++ = ',';
+                }
+            }
+            *q++ = '}';
+            break;
+    }
+    return q;
+}
+
+/* both engines must agree on the error, or on the stringified tree */
+static void test_engines(const char* json) {
+    lept_value v1, v2;
+    int ret;
+    lept_init(&v1);
+    lept_init(&v2);
+    ret = lept_parse(&v1, json);
+    EXPECT_EQ_INT(ret, lept_parse_ex(&v2, json, LEPT_PARSE_FLAG_INDEXED, NULL));
+    if (ret == LEPT_PARSE_OK && lept_get_type(&v2) == lept_get_type(&v1)) {
+        test_expect_same_tree(&v1, &v2);
+    }
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_indexed() {
+    static char buf[1 << 16];
+    int level, max;
+    size_t len, i;
+    char saved;
+    /* stage 2 reports errors itself: a scalar that runs on misses what follows it */
+    TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "truex");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1x]");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\": nullx}");
+    TEST_ERROR(LEPT_PARSE_MISS_COLON, "{\"a\"");
+
+    max = lept_set_simd(LEPT_SIMD_AVX2);
+    for (level = LEPT_SIMD_NONE; level <= max; level++) {
+        EXPECT_EQ_INT(level, lept_set_simd(level));
+        test_seed = 1;
+        for (i = 0; i < 300; i++) {
+            char* q = test_gen_space(buf);
+            q = test_gen_value(q, 0);
+            q = test_gen_space(q);
+            *q = '\0';
+            len = (size_t)(q - buf);
+            test_engines(buf);
+            /* damage one byte, or cut the document short */
+            q = buf + test_rand((unsigned)len);
+            saved = *q;
+            *q = "\"\\,:[]{}x\x01 "[test_rand(12)];
+            test_engines(buf);
+            *q = '\0';
+            test_engines(buf);
+            *q = saved;
+        }
+    }
+    lept_set_simd(max);
+}
+
+/* a tape node and a tree node hold the same value */
+static int test_tape_equal(const lept_tape* t, size_t node, const lept_value* v) {
+    size_t i, n;
+    if (lept_tape_get_type(t, node) != lept_get_type(v)) {
+        return 0;
+    }
+    switch (lept_get_type(v)) {
+        case LEPT_NUMBER:
+            return lept_tape_get_number(t, node) == lept_get_number(v);
+        case LEPT_INTEGER:
+            if (lept_get_number(v) < 0) {
+                return lept_tape_get_int64(t, node) == lept_get_int64(v);
+            }
+            return lept_tape_get_uint64(t, node) == lept_get_uint64(v);
+        case LEPT_STRING:
+            return lept_tape_get_string_length(t, node) == lept_get_string_length(v) &&
+                   memcmp(lept_tape_get_string(t, node), lept_get_string(v), lept_get_string_length(v) + 1) == 0;
+        case LEPT_ARRAY:
+            if ((n = lept_tape_get_array_size(t, node)) != lept_get_array_size(v)) {
+                return 0;
+            }
+            for (i = 0, node++; i < n; i++, node = lept_tape_next(t, node)) {
+                if (!test_tape_equal(t, node, lept_get_array_element(v, i))) {
+                    return 0;
+                }
+            }
+            return 1;
+        case LEPT_OBJECT:
+            if ((n = lept_tape_get_object_size(t, node)) != lept_get_object_size(v)) {
+                return 0;
+            }
+            for (i = 0; i < n; i++) {
+                if (lept_tape_get_object_key_length(t, node, i) != lept_get_object_key_length(v, i) ||
+                    memcmp(lept_tape_get_object_key(t, node, i), lept_get_object_key(v, i), lept_get_object_key_length(v, i)) != 0 ||
+                    !test_tape_equal(t, lept_tape_get_object_value(t, node, i), lept_get_object_value(v, i))) {
+                    return 0;
+                }
+            }
+            return 1;
+        default:
+            return 1;
+    }
+}
+
+static void test_parse_tape() {
+    static char buf[1 << 16];
+    const char* json = " { \"n\" : null , \"f\" : false , \"t\" : true , \"i\" : -123 , \"u\" : 18446744073709551615 , "
+        "\"d\" : 1.5 , \"s\" : \"abc\\u0000def\" , \"a\" : [ 1, \"12345678\", [ [ ] ], { } ] , "
+        "\"o\" : { \"1\" : 1 , \"2\" : 2 , \"3\" : 3 } } ";
+    lept_tape t;
+    lept_value v;
+    size_t node, a, i;
+    char* q;
+
+    lept_tape_init(&t);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_tape_parse(&t, json));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_tape_get_type(&t, 0));
+    EXPECT_EQ_SIZE_T(9, lept_tape_get_object_size(&t, 0));
+    EXPECT_EQ_SIZE_T(t.size, lept_tape_next(&t, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_tape_get_type(&t, lept_tape_get_object_value_by_key(&t, 0, "n", 1)));
+    EXPECT_FALSE(lept_tape_get_boolean(&t, lept_tape_get_object_value_by_key(&t, 0, "f", 1)));
+    EXPECT_TRUE(lept_tape_get_boolean(&t, lept_tape_get_object_value_by_key(&t, 0, "t", 1)));
+    EXPECT_EQ_INT64(-123, lept_tape_get_int64(&t, lept_tape_get_object_value_by_key(&t, 0, "i", 1)));
+    EXPECT_EQ_UINT64(18446744073709551615u, lept_tape_get_uint64(&t, lept_tape_get_object_value_by_key(&t, 0, "u", 1)));
+    EXPECT_EQ_DOUBLE(1.5, lept_tape_get_number(&t, lept_tape_get_object_value_by_key(&t, 0, "d", 1)));
+    node = lept_tape_get_object_value_by_key(&t, 0, "s", 1);
+    EXPECT_EQ_STRING("abc\0def", lept_tape_get_string(&t, node), lept_tape_get_string_length(&t, node));
+    a = lept_tape_get_object_value_by_key(&t, 0, "a", 1);
+    EXPECT_EQ_SIZE_T(4, lept_tape_get_array_size(&t, a));
+    node = lept_tape_get_array_element(&t, a, 1);
+    EXPECT_EQ_STRING("12345678", lept_tape_get_string(&t, node), lept_tape_get_string_length(&t, node));
+    EXPECT_EQ_SIZE_T(0, lept_tape_get_array_size(&t, lept_tape_get_array_element(&t, lept_tape_get_array_element(&t, a, 2), 0)));
+    EXPECT_EQ_SIZE_T(0, lept_tape_get_object_size(&t, lept_tape_get_array_element(&t, a, 3)));
+    node = lept_tape_get_object_value_by_key(&t, 0, "o", 1);
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ_INT64(i + 1, lept_tape_get_int64(&t, lept_tape_get_object_value(&t, node, i)));
+    }
+    EXPECT_EQ_SIZE_T(LEPT_TAPE_NONE, lept_tape_get_object_value_by_key(&t, node, "4", 1));
+    EXPECT_EQ_SIZE_T(LEPT_TAPE_NONE, lept_tape_get_object_value_by_key(&t, 0, "nn", 2));
+
+    /* the same values as the tree, on random documents */
+    test_seed = 7;
+    for (i = 0; i < 200; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        *q = '\0';
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_tape_parse(&t, buf));
+        EXPECT_TRUE(test_tape_equal(&t, 0, &v));
+        EXPECT_EQ_SIZE_T(t.size, lept_tape_next(&t, 0));
+        lept_free(&v);
+    }
+
+    /* and the same errors */
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_tape_parse(&t, " "));
+    EXPECT_EQ_SIZE_T(0, t.size);
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_tape_parse(&t, "[] x"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_tape_parse(&t, "[[1 2]]"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_KEY, lept_tape_parse(&t, "[{\"a\":1,}]"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_tape_parse(&t, "{\"a\" 1}"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_tape_parse(&t, "{\"a\":{}"));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_tape_parse(&t, "[\"\\v\"]"));
+    EXPECT_EQ_INT(LEPT_PARSE_NUMBER_TOO_BIG, lept_tape_parse(&t, "[1e309]"));
+    memset(buf, '[', LEPT_PARSE_MAX_DEPTH + 1);
+    buf[LEPT_PARSE_MAX_DEPTH + 1] = '\0';
+    EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_tape_parse(&t, buf));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_tape_parse(&t, "\"x\""));
+    EXPECT_EQ_SIZE_T(2, t.size);
+    lept_tape_free(&t);
+}
+
+/* a cursor node and a tree node hold the same value */
+static int test_ondemand_equal(lept_ondemand* d, size_t node, const lept_value* v) {
+    size_t i, n, e;
+    if (lept_ondemand_get_type(d, node) != lept_get_type(v)) {
+        return 0;
+    }
+    switch (lept_get_type(v)) {
+        case LEPT_NUMBER:
+            return lept_ondemand_get_number(d, node) == lept_get_number(v);
+        case LEPT_INTEGER:
+            if (lept_get_number(v) < 0) {
+                return lept_ondemand_get_int64(d, node) == lept_get_int64(v);
+            }
+            return lept_ondemand_get_uint64(d, node) == lept_get_uint64(v);
+        case LEPT_STRING:
+            return lept_ondemand_get_string_length(d, node) == lept_get_string_length(v) &&
+                   memcmp(lept_ondemand_get_string(d, node), lept_get_string(v), lept_get_string_length(v) + 1) == 0;
+        case LEPT_ARRAY:
+            if ((n = lept_ondemand_get_array_size(d, node)) != lept_get_array_size(v)) {
+                return 0;
+            }
+            for (i = 0, e = lept_ondemand_get_array_element(d, node, 0); i < n; i++, e = lept_ondemand_next(d, e)) {
+                if (!test_ondemand_equal(d, e, lept_get_array_element(v, i))) {
+                    return 0;
+                }
+            }
+            return e == LEPT_ONDEMAND_NONE;
+        case LEPT_OBJECT:
+            if ((n = lept_ondemand_get_object_size(d, node)) != lept_get_object_size(v)) {
+                return 0;
+            }
+            for (i = 0; i < n; i++) {
+                if (lept_ondemand_get_object_key_length(d, node, i) != lept_get_object_key_length(v, i) ||
+                    memcmp(lept_ondemand_get_object_key(d, node, i), lept_get_object_key(v, i), lept_get_object_key_length(v, i)) != 0 ||
+                    !test_ondemand_equal(d, lept_ondemand_get_object_value(d, node, i), lept_get_object_value(v, i))) {
+                    return 0;
+                }
+            }
+            return 1;
+        default:
+            return 1;
+    }
+}
+
+static void test_parse_ondemand() {
+    static char buf[1 << 16];
+    lept_ondemand d;
+    lept_value v;
+    size_t root, node, i;
+    char* q;
+
+    /* only what is walked has to be well-formed */
+    lept_ondemand_init(&d, " { \"skip\" : [ 1, { \"x\": tru } , \"]}\\\"\" ], \"a\\u0062\" : { \"n\" : -12.5e1, \"i\" : 7 }, "
+                           "\"s\" : \"x\\ny\", \"l\" : [ true , false , null ] , \"junk\" : ] ");
+    root = lept_ondemand_root(&d);
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_ondemand_get_type(&d, root));
+    node = lept_ondemand_get_object_value_by_key(&d, root, "ab", 2);
+    EXPECT_EQ_DOUBLE(-125.0, lept_ondemand_get_number(&d, lept_ondemand_get_object_value_by_key(&d, node, "n", 1)));
+    EXPECT_EQ_INT64(7, lept_ondemand_get_int64(&d, lept_ondemand_get_object_value_by_key(&d, node, "i", 1)));
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_get_object_value_by_key(&d, node, "z", 1));
+    node = lept_ondemand_get_object_value_by_key(&d, root, "s", 1);
+    EXPECT_EQ_STRING("x\ny", lept_ondemand_get_string(&d, node), lept_ondemand_get_string_length(&d, node));
+    node = lept_ondemand_get_object_value_by_key(&d, root, "l", 1);
+    EXPECT_EQ_SIZE_T(3, lept_ondemand_get_array_size(&d, node));
+    EXPECT_TRUE(lept_ondemand_get_boolean(&d, lept_ondemand_get_array_element(&d, node, 0)));
+    EXPECT_FALSE(lept_ondemand_get_boolean(&d, lept_ondemand_get_array_element(&d, node, 1)));
+    EXPECT_EQ_INT(LEPT_NULL, lept_ondemand_get_type(&d, lept_ondemand_get_array_element(&d, node, 2)));
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_get_array_element(&d, node, 3));
+    EXPECT_EQ_STRING("ab", lept_ondemand_get_object_key(&d, root, 1), lept_ondemand_get_object_key_length(&d, root, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_ondemand_get_error(&d));
+    /* walking into the broken parts reports them */
+    node = lept_ondemand_get_array_element(&d, lept_ondemand_get_object_value_by_key(&d, root, "skip", 4), 1);
+    EXPECT_EQ_INT(LEPT_NULL, lept_ondemand_get_type(&d, lept_ondemand_get_object_value_by_key(&d, node, "x", 1)));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_ondemand_get_error(&d));
+    lept_ondemand_free(&d);
+
+    lept_ondemand_init(&d, "{\"a\":1 \"b\":2}");
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_get_object_value_by_key(&d, lept_ondemand_root(&d), "b", 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_ondemand_get_error(&d));
+    lept_ondemand_init(&d, "[[1, \"2]\"");
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_get_array_element(&d, lept_ondemand_root(&d), 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_ondemand_get_error(&d));
+    lept_ondemand_init(&d, "  ");
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_root(&d));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_ondemand_get_error(&d));
+
+    /* indexing goes on from the child last reached, in any order and across containers */
+    q = buf + strlen(strcpy(buf, "[["));
+    for (i = 0; i < 3000; i++) {
+        q += sprintf(q, "%s{\"k\":[%u]}", i ? " , " : "", (unsigned)i);
+    }
+    strcpy(q, "],[7,8]]");
+    lept_ondemand_init(&d, buf);
+    root = lept_ondemand_root(&d);
+    node = lept_ondemand_get_array_element(&d, root, 0);
+    for (i = 0; i < 3000; i++) {
+        EXPECT_EQ_SIZE_T(i, (size_t)lept_ondemand_get_uint64(&d, lept_ondemand_get_array_element(&d,
+            lept_ondemand_get_object_value(&d, lept_ondemand_get_array_element(&d, node, i), 0), 0)));
+    }
+    EXPECT_EQ_SIZE_T(3000, lept_ondemand_get_array_size(&d, node));
+    EXPECT_EQ_SIZE_T(LEPT_ONDEMAND_NONE, lept_ondemand_get_array_element(&d, node, 3000));
+    for (i = 3000; i-- > 0; i -= i < 7 ? 0 : 7) {
+        EXPECT_EQ_SIZE_T(i, (size_t)lept_ondemand_get_uint64(&d, lept_ondemand_get_array_element(&d,
+            lept_ondemand_get_object_value_by_key(&d, lept_ondemand_get_array_element(&d, node, i), "k", 1), 0)));
+        EXPECT_EQ_INT64(8, lept_ondemand_get_int64(&d, lept_ondemand_get_array_element(&d,
+            lept_ondemand_get_array_element(&d, root, 1), 1)));
+    }
+    EXPECT_EQ_SIZE_T(2, lept_ondemand_get_array_size(&d, root));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_ondemand_get_error(&d));
+    lept_ondemand_free(&d);
+
+    /* the same values as the tree, on random documents */
+    test_seed = 11;
+    for (i = 0; i < 200; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        *q = '\0';
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        lept_ondemand_init(&d, buf);
+        EXPECT_TRUE(test_ondemand_equal(&d, lept_ondemand_root(&d), &v));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_ondemand_get_error(&d));
+        lept_ondemand_free(&d);
+        lept_free(&v);
+    }
+}
+
+/*
+ * a literal only strtod() can round: just above the midpoint of 1 and the
+ * next double, with the digit that decides it far past the 19th, under a
+ * locale whose decimal point is ',' if the system has one
+ */
+static void test_parse_locale() {
+    static const char* const names[] = { "", "de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR", "ru_RU.UTF-8" };
+    static char json[1024];
+    lept_ondemand d;
+    lept_value v;
+    size_t i, root;
+    char* q;
+
+    q = json + strlen(strcpy(json, "[\"abc\", 1.00000000000000011102230246251565404236316680908203125"));
+    memset(q, '0', 300);
+    strcpy(q + 300, "1, \"def\"]");
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (setlocale(LC_NUMERIC, names[i]) != NULL && *localeconv()->decimal_point == ',') {
+            break;
+        }
+    }
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_EQ_DOUBLE(1.0000000000000002220446049250313, lept_get_number(lept_get_array_element(&v, 1)));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, json, strlen(json)));
+    EXPECT_EQ_DOUBLE(1.0000000000000002220446049250313, lept_get_number(lept_get_array_element(&v, 1)));
+    lept_free(&v);
+
+    /* decoding the number leaves the cursor's decoded string alone */
+    lept_ondemand_init(&d, json);
+    root = lept_ondemand_root(&d);
+    EXPECT_EQ_STRING("abc", lept_ondemand_get_string(&d, lept_ondemand_get_array_element(&d, root, 0)), 3);
+    EXPECT_EQ_DOUBLE(1.0000000000000002220446049250313, lept_ondemand_get_number(&d, lept_ondemand_get_array_element(&d, root, 1)));
+    EXPECT_EQ_STRING("abc", lept_ondemand_get_string(&d, lept_ondemand_get_array_element(&d, root, 0)), 3);
+    EXPECT_EQ_STRING("def", lept_ondemand_get_string(&d, lept_ondemand_get_array_element(&d, root, 2)), 3);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_ondemand_get_error(&d));
+    lept_ondemand_free(&d);
+    setlocale(LC_NUMERIC, "C");
+}
+
+/* sax: an event log, compared with the same log taken from the tree */
+typedef struct {
+    char* q;
+    int stop_at;            /* cancel on this event, counting from 1 */
+    int events;
+}test_sax_log;
+
+static int test_sax_put(test_sax_log* log, char tag, const char* s, size_t len) {
+    *log->q++ = tag;
+    memcpy(log->q, s, len);
+    log->q += len;
+    *log->q++ = '|';
+    return ++log->events != log->stop_at;
+}
+
+static int test_sax_null(void* user) { return test_sax_put((test_sax_log*)user, 'n', "", 0); }
+static int test_sax_boolean(void* user, int b) { return test_sax_put((test_sax_log*)user, b ? 't' : 'f', "", 0); }
+static int test_sax_string(void* user, const char* s, size_t len) { return test_sax_put((test_sax_log*)user, 's', s, len); }
+static int test_sax_key(void* user, const char* k, size_t len) { return test_sax_put((test_sax_log*)user, 'k', k, len); }
+static int test_sax_start_object(void* user) { return test_sax_put((test_sax_log*)user, '{', "", 0); }
+static int test_sax_start_array(void* user) { return test_sax_put((test_sax_log*)user, '[', "", 0); }
+
+static int test_sax_number(void* user, const lept_value* v) {
+    char buf[32];
+    return test_sax_put((test_sax_log*)user, 'd', buf, (size_t)sprintf(buf, "%.17g", lept_get_number(v)));
+}
+
+static int test_sax_end_object(void* user, size_t size) {
+    char buf[32];
+    return test_sax_put((test_sax_log*)user, '}', buf, (size_t)sprintf(buf, "%u", (unsigned)size));
+}
+
+static int test_sax_end_array(void* user, size_t size) {
+    char buf[32];
+    return test_sax_put((test_sax_log*)user, ']', buf, (size_t)sprintf(buf, "%u", (unsigned)size));
+}
+
+static void test_sax_walk(test_sax_log* log, const lept_value* v) {
+    size_t i;
+    switch (lept_get_type(v)) {
+        case LEPT_NULL:   test_sax_null(log); break;
+        case LEPT_FALSE:  test_sax_boolean(log, 0); break;
+        case LEPT_TRUE:   test_sax_boolean(log, 1); break;
+        case LEPT_STRING: test_sax_string(log, lept_get_string(v), lept_get_string_length(v)); break;
+        case LEPT_ARRAY:
+            test_sax_start_array(log);
+            for (i = 0; i < lept_get_array_size(v); i++) {
+                test_sax_walk(log, lept_get_array_element(v, i));
+            }
+            test_sax_end_array(log, lept_get_array_size(v));
+            break;
+        case LEPT_OBJECT:
+            test_sax_start_object(log);
+            for (i = 0; i < lept_get_object_size(v); i++) {
+                test_sax_key(log, lept_get_object_key(v, i), lept_get_object_key_length(v, i));
+                test_sax_walk(log, lept_get_object_value(v, i));
+            }
+            test_sax_end_object(log, lept_get_object_size(v));
+            break;
+        default:
+            test_sax_number(log, v);
+            break;
+    }
+}
+
+static void test_parse_sax() {
+    static char buf[1 << 16], expect[1 << 17], actual[1 << 17];
+    lept_sax_handler h = {
+        test_sax_null, test_sax_boolean, test_sax_number, test_sax_string,
+        test_sax_start_object, test_sax_key, test_sax_end_object, test_sax_start_array, test_sax_end_array, NULL
+    };
+    lept_sax_handler empty = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    test_sax_log log;
+    lept_value v;
+    size_t i;
+    char *q, saved;
+    int ret;
+
+    h.user = &log;
+    log.q = actual;
+    log.events = 0;
+    log.stop_at = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(" { \"a\" : [ 1 , -2.5 , \"x\\ty\" , { } , [ ] ] , \"b\" : null , \"c\":true } ", &h));
+    *log.q = '\0';
+    EXPECT_TRUE(strcmp("{|ka|[|d1|d-2.5|sx\ty|{|}0|[|]0|]5|kb|n|kc|t|}3|", actual) == 0);
+
+    /* a callback returning 0 stops the parse */
+    log.q = actual;
+    log.events = 0;
+    log.stop_at = 3;
+    EXPECT_EQ_INT(LEPT_PARSE_CANCELLED, lept_parse_sax("[1, 2, 3]", &h));
+    EXPECT_EQ_INT(3, log.events);
+    log.events = 0;
+    log.stop_at = 1;
+    EXPECT_EQ_INT(LEPT_PARSE_CANCELLED, lept_parse_sax("1", &h));
+    log.stop_at = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax("[1, {\"a\": \"b\"}]", &empty));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_sax("[1, {\"a\" \"b\"}]", &empty));
+
+    /* the tree's values in the tree's order, and its errors */
+    test_seed = 13;
+    for (i = 0; i < 200; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        q = test_gen_space(q);
+        *q = '\0';
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        log.q = expect;
+        test_sax_walk(&log, &v);
+        *log.q = '\0';
+        lept_free(&v);
+        log.q = actual;
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax(buf, &h));
+        *log.q = '\0';
+        EXPECT_TRUE(strcmp(expect, actual) == 0);
+
+        q = buf + test_rand((unsigned)(q - buf));
+        saved = *q;
+        *q = "\"\\,:[]{}x\x01 "[test_rand(12)];
+        ret = lept_parse(&v, buf);
+        lept_free(&v);
+        log.q = actual;
+        EXPECT_EQ_INT(ret, lept_parse_sax(buf, &h));
+        *q = saved;
+    }
+}
+
+/* the reader's tokens as a sax log; returns the last token */
+static lept_token test_reader_log(test_sax_log* log, const char* json) {
+    lept_reader r;
+    lept_token t;
+    lept_reader_init(&r, json);
+    for (;;) {
+        switch (t = lept_reader_next(&r)) {
+            case LEPT_TOKEN_NULL:         test_sax_null(log); break;
+            case LEPT_TOKEN_FALSE:        test_sax_boolean(log, 0); break;
+            case LEPT_TOKEN_TRUE:         test_sax_boolean(log, 1); break;
+            case LEPT_TOKEN_NUMBER:       test_sax_number(log, lept_reader_get_value(&r)); break;
+            case LEPT_TOKEN_STRING:       test_sax_string(log, lept_reader_get_string(&r), lept_reader_get_string_length(&r)); break;
+            case LEPT_TOKEN_KEY:          test_sax_key(log, lept_reader_get_string(&r), lept_reader_get_string_length(&r)); break;
+            case LEPT_TOKEN_START_ARRAY:  test_sax_start_array(log); break;
+            case LEPT_TOKEN_END_ARRAY:    test_sax_end_array(log, lept_reader_get_size(&r)); break;
+            case LEPT_TOKEN_START_OBJECT: test_sax_start_object(log); break;
+            case LEPT_TOKEN_END_OBJECT:   test_sax_end_object(log, lept_reader_get_size(&r)); break;
+            default:
+                *log->q = '\0';
+                lept_reader_free(&r);
+                return t;
+        }
+    }
+}
+
+static void test_parse_reader() {
+    static char buf[1 << 16], expect[1 << 17], actual[1 << 17];
+    const char* json = "{\"id\": 42, \"name\": \"plain\", \"esc\": \"a\\u00e9b\", \"list\": [true, -1.5e3], \"rest\": [1, 2, 3]}";
+    test_alloc_count count = { 0, 0 };
+    lept_allocator a;
+    test_sax_log log;
+    lept_reader r;
+    lept_value v;
+    size_t i;
+    char *q, saved;
+    int ret;
+
+    a.alloc = test_alloc; a.realloc = test_realloc; a.free = test_free; a.user = &count;
+    lept_reader_init(&r, json);
+    EXPECT_EQ_INT(LEPT_TOKEN_START_OBJECT, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(&r));
+    EXPECT_EQ_STRING("id", lept_reader_get_string(&r), lept_reader_get_string_length(&r));
+    EXPECT_TRUE(lept_reader_get_string(&r) == json + 2);
+    EXPECT_EQ_INT(LEPT_TOKEN_NUMBER, lept_reader_next(&r));
+    EXPECT_EQ_INT64(42, lept_get_int64(lept_reader_get_value(&r)));
+    EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_STRING, lept_reader_next(&r));
+    EXPECT_EQ_STRING("plain", lept_reader_get_string(&r), lept_reader_get_string_length(&r));
+    /* a string without escapes is not copied */
+    EXPECT_TRUE(lept_reader_get_string(&r) == strstr(json, "plain"));
+    EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_STRING, lept_reader_next(&r));
+    EXPECT_EQ_STRING("a\xC3\xA9" "b", lept_reader_get_string(&r), lept_reader_get_string_length(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_KEY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_TRUE, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_NUMBER, lept_reader_next(&r));
+    EXPECT_EQ_DOUBLE(-1.5e3, lept_get_number(lept_reader_get_value(&r)));
+    EXPECT_EQ_INT(LEPT_TOKEN_END_ARRAY, lept_reader_next(&r));
+    EXPECT_EQ_SIZE_T(2, lept_reader_get_size(&r));
+    /* stop early */
+    lept_reader_free(&r);
+
+    /* only open containers take memory */
+    lept_reader_init(&r, "\"no escapes\"");
+    lept_reader_set_allocator(&r, &a);
+    EXPECT_EQ_INT(LEPT_TOKEN_STRING, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(&r));
+    lept_reader_free(&r);
+    EXPECT_EQ_INT(0, count.allocs);
+    for (q = buf, i = 0; i < 1000; i++) {
+        q += sprintf(q, "%s\"string %u\"", i ? "," : "[", (unsigned)i);
+    }
+    strcpy(q, "]");
+    lept_reader_init(&r, buf);
+    lept_reader_set_allocator(&r, &a);
+    while (lept_reader_next(&r) < LEPT_TOKEN_END) {
+    }
+    lept_reader_free(&r);
+    EXPECT_EQ_INT(1, count.allocs);
+    EXPECT_EQ_INT(1, count.frees);
+
+    lept_reader_init(&r, "[1] [");
+    EXPECT_EQ_INT(LEPT_TOKEN_START_ARRAY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_NUMBER, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_END_ARRAY, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_ERROR, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_reader_get_error(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_ERROR, lept_reader_next(&r));
+    lept_reader_free(&r);
+    lept_reader_init(&r, " null ");
+    EXPECT_EQ_INT(LEPT_TOKEN_NULL, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_TOKEN_END, lept_reader_next(&r));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_reader_get_error(&r));
+    lept_reader_free(&r);
+
+    /* the tree's values in the tree's order, and its errors */
+    log.stop_at = 0;
+    test_seed = 17;
+    for (i = 0; i < 200; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        q = test_gen_space(q);
+        *q = '\0';
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        log.q = expect;
+        test_sax_walk(&log, &v);
+        *log.q = '\0';
+        lept_free(&v);
+        log.q = actual;
+        EXPECT_EQ_INT(LEPT_TOKEN_END, test_reader_log(&log, buf));
+        EXPECT_TRUE(strcmp(expect, actual) == 0);
+
+        q = buf + test_rand((unsigned)(q - buf));
+        saved = *q;
+        *q = "\"\\,:[]{}x\x01 "[test_rand(12)];
+        ret = lept_parse(&v, buf);
+        lept_free(&v);
+        log.q = actual;
+        lept_reader_init(&r, buf);
+        while (lept_reader_next(&r) < LEPT_TOKEN_END) {
+        }
+        EXPECT_EQ_INT(ret, lept_reader_get_error(&r));
+        lept_reader_free(&r);
+        *q = saved;
+    }
+}
+
+/* feeds json in chunks of at most max bytes, max 0 for random sizes */
+static int test_stream(lept_value* v, const char* json, size_t max) {
+    lept_stream s;
+    size_t len = strlen(json), n;
+    int ret = LEPT_PARSE_OK;
+    lept_stream_init(&s);
+    while (len != 0 && ret == LEPT_PARSE_OK) {
+        n = max ? max : 1 + test_rand(40);
+        n = n < len ? n : len;
+        ret = lept_stream_feed(&s, json, n);
+        json += n;
+        len -= n;
+    }
+    if (ret != LEPT_PARSE_OK) {
+        /* an error found early stands */
+        EXPECT_EQ_INT(ret, lept_stream_finish(&s, v));
+        return ret;
+    }
+    return lept_stream_finish(&s, v);
+}
+
+/* the stream agrees with lept_parse() on the error, or on the stringified tree */
+static void test_stream_equal(const char* json, size_t max) {
+    lept_value v1, v2;
+    int ret;
+    lept_init(&v1);
+    ret = lept_parse(&v1, json);
+    v2.type = LEPT_FALSE;
+    EXPECT_EQ_INT(ret, test_stream(&v2, json, max));
+    if (ret == LEPT_PARSE_OK) {
+        test_expect_same_tree(&v1, &v2);
+    }else {
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+    }
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_stream() {
+    static char buf[1 << 16];
+    static const char* const cases[] = {
+        "null", " true ", "false", "-0", "12345678901234567890", "-1.5e-300", "1e400",
+        "\"\"", "\"a\\u00e9\\uD834\\uDD1E\\n\"", "\"\\uD834x\"", "\"\\q\"",
+        "[]", "[ 1 , [ true ] , { } ]", "{\"a\" : {\"b\": [null, \"c\"]}, \"d\":0}",
+        "", " ", "nul", "tru", "-", "1.", "1e", "[1,]", "[1 2]", "{\"a\" 1}", "{1:2}", "{\"a\":1,}",
+        "[\"abc", "1 2", "[1] x", "\"\x01\""
+    };
+    lept_stream s;
+    lept_value v;
+    size_t i, max;
+    char* q;
+
+    /* every chunk size, down to one byte at a time */
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (max = 1; max <= 8; max++) {
+            test_stream_equal(cases[i], max);
+        }
+    }
+
+    /* the error comes with the chunk that completes the token at fault */
+    lept_stream_init(&s);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "[tr", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "ue, nul", 7));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_stream_feed(&s, "x]", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_stream_feed(&s, "]", 1));
+    v.type = LEPT_FALSE;
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_stream_finish(&s, &v));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    lept_stream_init(&s);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "{\"k\":1", 6));
+    lept_stream_free(&s);
+
+    /* the buffer holds a chunk and the unfinished token, never the document */
+    lept_stream_init(&s);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "[", 1));
+    for (i = 0; i < 10000; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "\"0123456789\", 12345,", 20));
+    }
+    EXPECT_TRUE(s.cap <= 256);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&s, "0]", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_finish(&s, &v));
+    EXPECT_EQ_SIZE_T(20001, lept_get_array_size(&v));
+    lept_free(&v);
+
+    /* long tokens one byte at a time: a key, a string value with escapes, whitespace, a number */
+    q = buf + strlen(strcpy(buf, "{\""));
+    for (i = 0; i < 20000; i++) {
+        *q++ = (char)('a' + i % 26);
+    }
+    q += strlen(strcpy(q, "\" : \""));
+    for (i = 0; i < 4000; i++) {
+        q += strlen(strcpy(q, i % 3 ? "abcd\\\"" : "\\u00e9\\n"));
+    }
+    q += strlen(strcpy(q, "\" ,"));
+    memset(q, ' ', 5000);
+    q += 5000;
+    q += strlen(strcpy(q, "\"n\": -"));
+    memset(q, '7', 3000);
+    strcpy(q + 3000, "e-3000}");
+    test_stream_equal(buf, 1);
+
+    test_seed = 19;
+    for (i = 0; i < 300; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        q = test_gen_space(q);
+        *q = '\0';
+        test_stream_equal(buf, 0);
+        test_stream_equal(buf, 1);
+        /* damage one byte, or cut the document short */
+        q = buf + test_rand((unsigned)(q - buf));
+        *q = "\"\\,:[]{}x\x01 "[test_rand(12)];
+        test_stream_equal(buf, 0);
+        *q = '\0';
+        test_stream_equal(buf, 0);
+    }
+}
+
+
+typedef struct {
+    const char* p;          /* the input from line `lines` on, to parse each line again */
+    size_t lines, records, stop_at;
+}test_ndjson_log;
+
+static int test_ndjson_record(void* user, size_t line, lept_value* v, int ret) {
+    test_ndjson_log* log = (test_ndjson_log*)user;
+    static char one[1 << 14];
+    const char* q;
+    lept_value expect;
+    size_t n;
+    /* lines come in order */
+    EXPECT_TRUE(log->records == 0 ? line >= log->lines : line > log->lines);
+    for (; log->lines < line; log->lines++) {
+        log->p = strchr(log->p, '\n') + 1;
+    }
+    q = strchr(log->p, '\n');
+    n = q ? (size_t)(q - log->p) : strlen(log->p);
+    memcpy(one, log->p, n);
+    one[n] = '\0';
+    lept_init(&expect);
+    EXPECT_EQ_INT(lept_parse(&expect, one), ret);
+    if (ret == LEPT_PARSE_OK) {
+        test_expect_same_tree(&expect, v);
+    }else {
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(v));
+    }
+    lept_free(&expect);
+    lept_free(v);
+    return ++log->records != log->stop_at;
+}
+
+static void test_parse_ndjson() {
+    static char buf[1 << 19];
+    const char* json = "1\r\n\r\n  [2]";
+    test_ndjson_log log;
+    size_t threads, lines, blanks;
+    char *q, *r;
+
+    /* records, blank lines and bad lines; a record's whitespace has no '\n' */
+    test_seed = 23;
+    q = buf;
+    for (lines = blanks = 0; q < buf + sizeof(buf) - (1 << 14); lines++) {
+        r = q;
+        switch (test_rand(8)) {
+            case 0:  q = test_gen_space(q); blanks++; break;
+            case 1:  q += strlen(strcpy(q, "[1, }")); break;
+            default: q = test_gen_value(q, 0); break;
+        }
+        for (; r < q; r++) {
+            if (*r == '\n') {
+                *r = ' ';
+            }
+        }
+        *q++ = '\n';
+    }
+    *q = '\0';
+
+    for (threads = 0; threads <= 4; threads++) {
+        log.p = buf;
+        log.lines = log.records = log.stop_at = 0;
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson(buf, (size_t)(q - buf), threads, test_ndjson_record, &log));
+        EXPECT_EQ_SIZE_T(lines - blanks, log.records);
+        /* stop early: the rest is freed and the callback not called again */
+        log.p = buf;
+        log.lines = log.records = 0;
+        log.stop_at = 1000;
+        EXPECT_EQ_INT(LEPT_PARSE_CANCELLED, lept_parse_ndjson(buf, (size_t)(q - buf), threads, test_ndjson_record, &log));
+        EXPECT_EQ_SIZE_T(1000, log.records);
+    }
+
+    /* '\r\n' line ends, a last line without one, an empty input */
+    log.p = json;
+    log.lines = log.records = log.stop_at = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson(json, strlen(json), 2, test_ndjson_record, &log));
+    EXPECT_EQ_SIZE_T(2, log.records);
+    EXPECT_EQ_SIZE_T(2, log.lines);
+    log.records = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson("", 0, 2, test_ndjson_record, &log));
+    EXPECT_EQ_SIZE_T(0, log.records);
+}
+
+/* the first len bytes of json, followed by tail, parse as json cut at len */
+static void test_parse_n_equal(const char* json, size_t len, const char* tail) {
+    size_t n = strlen(tail);
+    char* buf = (char*)malloc(len + n + 1);     /* exact fit: out-of-bounds reads trap */
+    char* cut = (char*)malloc(len + 1);
+    lept_value v1, v2;
+    memcpy(buf, json, len);
+    memcpy(buf + len, tail, n);
+    memcpy(cut, json, len);
+    cut[len] = '\0';
+    lept_init(&v1);
+    v2.type = LEPT_FALSE;
+    EXPECT_EQ_INT(lept_parse(&v1, cut), lept_parse_n(&v2, buf, len));
+    if (lept_get_type(&v1) != LEPT_NULL) {
+        test_expect_same_tree(&v1, &v2);
+    }else {
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+    }
+    lept_free(&v1);
+    lept_free(&v2);
+    free(cut);
+    free(buf);
+}
+
+static void test_parse_n() {
+    static const char* const cases[] = {
+        "null", "true", "false", "0", "-12", "18446744073709551615", "1.5e300", "1e400",
+        "1.000000000000000111022302462515654042363166809082031250001",
+        "\"\"", "\"abc\"", "\"\\u00e9\\uD834\\uDD1E\\t\"", "\"\\uD834\"",
+        "[1, [2, {\"a\": \"b\"}], {}, []]", "{\"k\" : [true, null] }  "
+    };
+    static const char* const tails[] = { "", "\\", "1", "e5", "\"", "\\u0041\"", " x", "]}" };
+    static char buf[1 << 16];
+    lept_value v;
+    size_t i, j, len;
+    char* q;
+
+    /* every prefix, with whatever follows it in memory */
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (len = 0; len <= strlen(cases[i]); len++) {
+            for (j = 0; j < sizeof(tails) / sizeof(tails[0]); j++) {
+                test_parse_n_equal(cases[i], len, tails[j]);
+            }
+        }
+    }
+
+    /* '\0' is content only escaped */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "\"a\\u0000b\"", 10));
+    EXPECT_EQ_STRING("a\0b", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse_n(&v, "\"a\0b\"", 5));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_n(&v, "1\0", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_n(&v, "[\0]", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_n(&v, "", 0));
+
+    test_seed = 29;
+    for (i = 0; i < 200; i++) {
+        q = test_gen_space(buf);
+        q = test_gen_value(q, 0);
+        q = test_gen_space(q);
+        *q = '\0';
+        len = (size_t)(q - buf);
+        test_parse_n_equal(buf, len, "");
+        test_parse_n_equal(buf, test_rand((unsigned)len), tails[test_rand(8)]);
+    }
+}
+
+/* writes json to a file, padded with spaces to size bytes */
+static void test_parse_file_size(const char* json, size_t size) {
+    static const int flags[] = { 0, LEPT_PARSE_FLAG_INDEXED };
+    const char* path = "leptjson_test.json";
+    lept_value v1, v2;
+    size_t i;
+    FILE* fp = fopen(path, "wb");
+    EXPECT_TRUE(fp != NULL);
+    if (fp == NULL) {
+        return;
+    }
+    fputs(json, fp);
+    for (i = strlen(json); i < size; i++) {
+        fputc(' ', fp);
+    }
+    fclose(fp);
+    for (i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+        lept_init(&v1);
+        lept_init(&v2);
+        EXPECT_EQ_INT(lept_parse(&v1, json), lept_parse_file(&v2, path, flags[i]));
+        if (lept_get_type(&v1) != LEPT_NULL) {
+            test_expect_same_tree(&v1, &v2);
+        }
+        lept_free(&v1);
+        lept_free(&v2);
+    }
+    remove(path);
+}
+
+static void test_parse_file() {
+    static const char* const cases[] = {
+        "{\"a\": [1, 2.5, \"x\\u00e9\", true, null], \"b\": {}}", "[1, 2", "", "1 2",
+        "[1x]", "{\"a\" 1}", "{\"a\": nul}", "\"abc"
+    };
+    lept_value v;
+    size_t i;
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        test_parse_file_size(cases[i], 0);
+        /* on whole pages the file has no zeros after it */
+        test_parse_file_size(cases[i], 4096);
+        test_parse_file_size(cases[i], 8192);
+        test_parse_file_size(cases[i], 4097);
+    }
+    v.type = LEPT_FALSE;
+    EXPECT_EQ_INT(LEPT_PARSE_IO_ERROR, lept_parse_file(&v, "leptjson_test_missing.json", 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_parse_keys_equal(const char* json, const char* const* keys, size_t n, const char* expect) {
+    lept_value v1, v2;
+    lept_init(&v1);
+    lept_init(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, expect));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_keys(&v2, json, keys, n));
+    test_expect_same_tree(&v1, &v2);
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_keys() {
+    static const char* const ab[] = { "a", "b" };
+    static const char* const skipped[] = {
+        "null", "-1.5e3", "\"x\\\"]}\"", "[]", "{}", "[1, \"]\", [\"\\\\\", {\"[\": \"}\"}]]",
+        "{\"a\": {\"a\": [[[\"\\u005D\"]]]}}", "[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]"
+    };
+    static char buf[1 << 16], want[1 << 16];
+    lept_value v;
+    size_t i, level, max, off;
+    char *q, *w, *b;
+    int ret;
+
+    test_parse_keys_equal(" { \"a\" : 1 , \"c\" : [2] , \"b\" : \"x\" } ", ab, 2, "{\"a\":1,\"b\":\"x\"}");
+    test_parse_keys_equal("{\"b\":1,\"a\":2,\"b\":3}", ab, 2, "{\"b\":1,\"a\":2,\"b\":3}");
+    test_parse_keys_equal("{\"\\u0061\":true,\"ab\":false}", ab, 2, "{\"a\":true}");
+    test_parse_keys_equal("{\"a\":1,\"b\":2}", ab, 0, "{}");
+    test_parse_keys_equal("{}", ab, 2, "{}");
+    test_parse_keys_equal("[{\"c\":1}]", ab, 2, "[{\"c\":1}]");
+    test_parse_keys_equal("\"a\"", ab, 2, "\"a\"");
+    for (i = 0; i < sizeof(skipped) / sizeof(skipped[0]); i++) {
+        sprintf(buf, "{\"c\": %s, \"b\": [%s], \"d\":%s}", skipped[i], skipped[i], skipped[i]);
+        sprintf(want, "{\"b\": [%s]}", skipped[i]);
+        test_parse_keys_equal(buf, ab, 2, want);
+    }
+
+    /* errors in a skipped value that hide its end, and around it */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_keys(&v, "{\"c\":\"x}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_keys(&v, "{\"c\":[\"x\\\"]}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse_keys(&v, "{\"c\":\"\x01\"}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_keys(&v, "{\"c\":[[1]", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_keys(&v, "{\"c\":{\"d\":[]", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_keys(&v, "{\"c\":}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_KEY, lept_parse_keys(&v, "{\"a\":1,}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_keys(&v, "{\"a\" 1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_keys(&v, "{\"c\":1 \"a\":2}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_keys(&v, "{\"b\":[1],\"a\":nul}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_keys(&v, "{\"x\":[}, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_keys(&v, "{\"x\":nul, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_keys(&v, "{\"x\":[1}, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_keys(&v, "{\"x\":{\"y\":1], \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_keys(&v, "{\"x\":01, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_parse_keys(&v, "{\"x\":[\"\\q\"], \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_keys(&v, "{\"x\":{\"y\"}, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_NUMBER_TOO_BIG, lept_parse_keys(&v, "{\"x\":1e309, \"a\":1}", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_keys(&v, "{\"a\":1} x", ab, 2));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_keys(&v, " ", ab, 2));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* skipped values long enough to take several SIMD blocks, with brackets and quotes at every offset */
+    max = (size_t)lept_set_simd(LEPT_SIMD_AVX2);
+    for (level = LEPT_SIMD_NONE; level <= max; level++) {
+        EXPECT_EQ_INT((int)level, lept_set_simd((int)level));
+        for (off = 0; off < 32; off++) {
+            for (i = 0; i < 80; i++) {
+                b = buf + off;
+                q = b + strlen(strcpy(b, "{\"c\":[\""));
+                memset(q, 'x', i);
+                q += strlen(strcpy(q + i, "\\\"]\",")) + i;
+                memset(q, '1', i + 1);
+                strcpy(q + i + 1, "],\"a\":1}");
+                test_parse_keys_equal(b, ab, 2, "{\"a\":1}");
+                strcpy(q + i + 1, "]");
+                EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_keys(&v, b, ab, 2));
+            }
+        }
+    }
+    lept_set_simd((int)max);
+
+    test_seed = 31;
+    for (i = 0; i < 300; i++) {
+        q = buf + strlen(strcpy(buf, "{\"c\":"));
+        w = want + strlen(strcpy(want, "{\"b\":"));
+        q = test_gen_value(q, 0);
+        q += strlen(strcpy(q, ",\"b\":"));
+        b = q;
+        q = test_gen_value(q, 0);
+        memcpy(w, b, (size_t)(q - b));
+        w += q - b;
+        q = test_gen_space(q);
+        q += strlen(strcpy(q, ",\"d\":"));
+        q = test_gen_value(q, 0);
+        strcpy(q, "}");
+        strcpy(w, "}");
+        test_parse_keys_equal(buf, ab, 2, want);
+        /* a skipped value fails as lept_parse() fails on it */
+        buf[test_rand((unsigned)(q - buf))] = "x]}\"\\,:0["[test_rand(9)];
+        ret = lept_parse(&v, buf);
+        lept_free(&v);
+        EXPECT_EQ_INT(ret, lept_parse_keys(&v, buf, ab, 0));
+        lept_free(&v);
+    }
+}
+
+static void test_parse_project_equal(const char* json, const char* const* paths, size_t n, const char* expect) {
+    lept_value v1, v2;
+    lept_init(&v1);
+    lept_init(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v1, expect));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_project(&v2, json, paths, n));
+    test_expect_same_tree(&v1, &v2);
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_project() {
+    static const char* doc =
+        " { \"a\" : { \"b\" : [ 10, { \"c\" : 1, \"d\" : [2] }, 30 ], \"e\" : \"x\" },"
+        " \"f~/g\" : [ 1, 2 ], \"h\" : null, \"\" : { \"\" : 3 } } ";
+    static const char* const p0[] = { "/a/b/1/c" };
+    static const char* const p1[] = { "/h", "/a/e", "/a/b/1/d" };
+    static const char* const p2[] = { "/a/b/2", "/a/b/0" };
+    static const char* const p3[] = { "/f~0~1g/1" };
+    static const char* const p4[] = { "//" };
+    static const char* const p5[] = { "/a/b/1", "/a" };
+    static const char* const p6[] = { "/h/x/y", "/a/e/0" };
+    static const char* const p7[] = { "/a/b/01", "/a/b/-", "/a/b/3", "/a/b/", "/a/b/18446744073709551616" };
+    static const char* const p8[] = { "/zz", "/f~/g", "/f~2g", "/f~" };
+    static const char* const p9[] = { "", "/a" };
+    static const char* const one[] = { "/b" };
+    static const char* const whole[] = { "" };
+    static char buf[1 << 16], want[1 << 16];
+    lept_value v;
+    size_t i;
+    char *q, *w, *b;
+
+    test_parse_project_equal(doc, p0, sizeof(p0) / sizeof(p0[0]), "{\"a\":{\"b\":[{\"c\":1}]}}");
+    test_parse_project_equal(doc, p1, sizeof(p1) / sizeof(p1[0]), "{\"a\":{\"b\":[{\"d\":[2]}],\"e\":\"x\"},\"h\":null}");
+    test_parse_project_equal(doc, p2, sizeof(p2) / sizeof(p2[0]), "{\"a\":{\"b\":[10,30]}}");
+    test_parse_project_equal(doc, p3, sizeof(p3) / sizeof(p3[0]), "{\"f~/g\":[2]}");
+    test_parse_project_equal(doc, p4, sizeof(p4) / sizeof(p4[0]), "{\"\":{\"\":3}}");
+    test_parse_project_equal(doc, p5, sizeof(p5) / sizeof(p5[0]), "{\"a\":{\"b\":[10,{\"c\":1,\"d\":[2]},30],\"e\":\"x\"}}");
+    test_parse_project_equal(doc, p6, sizeof(p6) / sizeof(p6[0]), "{\"a\":{\"e\":\"x\"},\"h\":null}");
+    test_parse_project_equal(doc, p7, sizeof(p7) / sizeof(p7[0]), "{\"a\":{\"b\":[]}}");
+    test_parse_project_equal(doc, p8, sizeof(p8) / sizeof(p8[0]), "{}");
+    test_parse_project_equal(doc, p9, sizeof(p9) / sizeof(p9[0]), doc);
+    test_parse_project_equal(doc, one, 0, "{}");
+    test_parse_project_equal("[[1,2],[3,4]]", one, 1, "[]");
+    test_parse_project_equal("\"s\"", one, 1, "\"s\"");
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_project(&v, "{\"c\":[\"x]}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_project(&v, "{\"c\":1,\"b\":[nul]}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_project(&v, "{\"c\":[nul],\"b\":1}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_project(&v, "{\"c\":[{}},\"b\":1}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_parse_project(&v, "{\"c\":\"\\x\",\"b\":1}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_project(&v, "{\"b\" 1}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_project(&v, "{\"c\" 1}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_KEY, lept_parse_project(&v, "{\"b\":1,}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_project(&v, "{\"b\":1 \"c\":2}", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_project(&v, "[1 2]", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_project(&v, "{\"b\":1} 2", one, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_project(&v, "", one, 1));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* nesting counts from the root whether or not the containers are projected */
+    q = buf;
+    for (i = 0; i < LEPT_PARSE_MAX_DEPTH; i++) {
+        *q++ = '[';
+    }
+    memset(q, ']', LEPT_PARSE_MAX_DEPTH);
+    q[LEPT_PARSE_MAX_DEPTH] = '\0';
+    test_parse_project_equal(buf, whole, 1, buf);
+    q = want;
+    for (i = 0; i < 600; i++) {
+        q += strlen(strcpy(q, "/0"));
+    }
+    w = want;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_project(&v, buf, (const char* const*)&w, 1));
+    lept_free(&v);
+    buf[LEPT_PARSE_MAX_DEPTH] = '[';
+    strcpy(buf + LEPT_PARSE_MAX_DEPTH + 1, "]");
+    memset(buf + LEPT_PARSE_MAX_DEPTH + 2, ']', LEPT_PARSE_MAX_DEPTH);
+    buf[2 * LEPT_PARSE_MAX_DEPTH + 2] = '\0';
+    EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse_project(&v, buf, (const char* const*)&w, 1));
+    EXPECT_EQ_INT(LEPT_PARSE_TOO_DEEP, lept_parse_project(&v, buf, whole, 1));
+
+    test_seed = 37;
+    for (i = 0; i < 300; i++) {
+        q = buf + strlen(strcpy(buf, "{\"c\":"));
+        w = want + strlen(strcpy(want, "{\"b\":"));
+        q = test_gen_value(q, 0);
+        q += strlen(strcpy(q, ",\"b\":"));
+        b = q;
+        q = test_gen_value(q, 0);
+        memcpy(w, b, (size_t)(q - b));
+        w += q - b;
+        q = test_gen_space(q);
+        q += strlen(strcpy(q, ",\"d\":"));
+        q = test_gen_value(q, 0);
+        strcpy(q, "}");
+        strcpy(w, "}");
+        test_parse_project_equal(buf, one, 1, want);
+        test_parse_project_equal(buf, whole, 1, buf);
+    }
+}
+
+/* reference for LEPT_PARSE_FLAG_VALIDATE_UTF8, by decoding */
+static int test_utf8_valid(const unsigned char* s, size_t n) {
+    size_t i = 0, len, k;
+    unsigned u;
+    while (i < n) {
+        if (s[i] < 0x80) {
+            i++;
+            continue;
+        }
+        if (s[i] >= 0xC0 && s[i] < 0xE0) {
+            len = 2;
+            u = s[i] & 0x1F;
+        }else if (s[i] >= 0xE0 && s[i] < 0xF0) {
+            len = 3;
+            u = s[i] & 0x0F;
+        }else if (s[i] >= 0xF0 && s[i] < 0xF8) {
+            len = 4;
+            u = s[i] & 0x07;
+        }else {
+            return 0;
+        }
+        if (n - i < len) {
+            return 0;
+        }
+        for (k = 1; k < len; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) {
+                return 0;
+            }
+            u = (u << 6) | (s[i + k] & 0x3F);
+        }
+        if (u < (len == 2 ? 0x80u : len == 3 ? 0x800u : 0x10000u) || u > 0x10FFFF || (u >= 0xD800 && u <= 0xDFFF)) {
+            return 0;
+        }
+        i += len;
+    }
+    return 1;
+}
+
+static void test_parse_utf8() {
+    static const char* const pieces[] = {
+        "a", "abcdefghijklmnopqrstuvwxyz0123456789", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xE4\xB8\xAD",
+        "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\\n", "\\u00e9",
+        /* ill-formed: stray, overlong, surrogate, too large, cut short */
+        "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF0\x8F\xBF\xBF",
+        "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xE4\xB8", "\xF0\x90\x80", "\xC3"
+    };
+    static char buf[4096];
+    lept_value v;
+    int level, max, valid;
+    size_t i, j, n, len;
+    char* q;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, "\"\xE4\xB8\xAD\xF0\x9F\x98\x80\"", LEPT_PARSE_FLAG_VALIDATE_UTF8, NULL));
+    EXPECT_EQ_STRING("\xE4\xB8\xAD\xF0\x9F\x98\x80", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, lept_parse_ex(&v, "\"\xC0\xAF\"", LEPT_PARSE_FLAG_VALIDATE_UTF8, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, lept_parse_ex(&v, "[\"a\", {\"\xFF\": 1}]", LEPT_PARSE_FLAG_VALIDATE_UTF8, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UTF8, lept_parse_ex(&v, "{\"k\":\"\xE4\xB8\\n\"}",
+                                                         LEPT_PARSE_FLAG_VALIDATE_UTF8 | LEPT_PARSE_FLAG_INDEXED, NULL));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "\"\xC0\xAF\""));
+    lept_free(&v);
+
+    /* every SIMD level agrees with the reference, sequences straddling blocks at every offset */
+    max = lept_set_simd(LEPT_SIMD_AVX2);
+    for (level = LEPT_SIMD_NONE; level <= max; level++) {
+        EXPECT_EQ_INT(level, lept_set_simd(level));
+        test_seed = 41;
+        for (i = 0; i < 3000; i++) {
+            q = buf;
+            *q++ = '\"';
+            for (j = 0, n = test_rand(64); j < n; j++) {
+                q += strlen(strcpy(q, pieces[test_rand(i % 3 == 0 ? 26 : 13)]));
+            }
+            *q++ = '\"';
+            *q = '\0';
+            len = (size_t)(q - buf);
+            /* escapes are ASCII, so the bytes between the quotes can be checked whole */
+            valid = test_utf8_valid((const unsigned char*)buf + 1, len - 2);
+            EXPECT_EQ_INT(valid ? LEPT_PARSE_OK : LEPT_PARSE_INVALID_UTF8,
+                          lept_parse_ex(&v, buf, LEPT_PARSE_FLAG_VALIDATE_UTF8, NULL));
+            lept_free(&v);
+        }
+    }
+    lept_set_simd(max);
+}
+
+/* long runs of escapes, mostly \u for non-ASCII text, against their decoding */
+static void test_parse_escape_heavy() {
+    static const struct { const char* json; const char* s; size_t len; } pieces[] = {
+        { "\\u4e2d", "\xE4\xB8\xAD", 3 }, { "\\u4E2D", "\xE4\xB8\xAD", 3 }, { "\\u00e9", "\xC3\xA9", 2 },
+        { "\\uD83D\\uDE00", "\xF0\x9F\x98\x80", 4 }, { "\\udbff\\udfff", "\xF4\x8F\xBF\xBF", 4 },
+        { "\\u0000", "\0", 1 }, { "\\u007F", "\x7F", 1 }, { "\\u0080", "\xC2\x80", 2 }, { "\\u07ff", "\xDF\xBF", 2 },
+        { "\\u0800", "\xE0\xA0\x80", 3 }, { "\\uFFFF", "\xEF\xBF\xBF", 3 }, { "\\\"", "\"", 1 }, { "\\\\", "\\", 1 },
+        { "\\/", "/", 1 }, { "\\b", "\b", 1 }, { "\\f", "\f", 1 }, { "\\n", "\n", 1 }, { "\\r", "\r", 1 },
+        { "\\t", "\t", 1 }, { "x", "x", 1 }
+    };
+    static char json[4096], want[4096], copy[4096];
+    lept_value v;
+    size_t i, j, k, n, len;
+    char *q, *w;
+
+    /* each byte as a hex digit */
+    for (i = 0; i < 256; i++) {
+        int digit = (i >= '0' && i <= '9') || (i >= 'a' && i <= 'f') || (i >= 'A' && i <= 'F');
+        for (j = 0; j < 4; j++) {
+            strcpy(json, "\"\\u0041\"");
+            json[3 + j] = (char)i;
+            if (digit) {
+                lept_init(&v);
+                EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+                EXPECT_EQ_INT(LEPT_STRING, lept_get_type(&v));
+                lept_free(&v);
+            }else if (i != 0) {
+                TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX, json);
+            }
+        }
+    }
+
+    test_seed = 43;
+    for (i = 0; i < 500; i++) {
+        q = json;
+        w = want;
+        *q++ = '\"';
+        for (j = 0, n = test_rand(120); j < n; j++) {
+            k = test_rand(sizeof(pieces) / sizeof(pieces[0]));
+            q += strlen(strcpy(q, pieces[k].json));
+            memcpy(w, pieces[k].s, pieces[k].len);
+            w += pieces[k].len;
+        }
+        strcpy(q, "\"");
+        len = (size_t)(w - want);
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+        EXPECT_TRUE(memcmp(want, lept_get_string(&v), len) == 0);
+        lept_free(&v);
+        strcpy(copy, json);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, copy));
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+        EXPECT_TRUE(memcmp(want, lept_get_string(&v), len) == 0);
+        lept_free(&v);
+        /* an error at the end of the run leaves nothing behind */
+        strcpy(q, "\\uD800\\u0041\"");
+        TEST_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, json);
+    }
+}
+
+static void test_parse_parallel_equal(const char* json, size_t len, size_t threads) {
+    lept_value v1, v2;
+    lept_init(&v1);
+    v2.type = LEPT_FALSE;
+    EXPECT_EQ_INT(lept_parse_n(&v1, json, len), lept_parse_parallel(&v2, json, len, threads));
+    if (lept_get_type(&v1) != LEPT_NULL) {
+        test_expect_same_tree(&v1, &v2);
+    }else {
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+    }
+    lept_free(&v1);
+    lept_free(&v2);
+}
+
+static void test_parse_parallel() {
+    static const char* const cases[] = {
+        "", " ", "[]", " [ ] ", "[1]", "[1,]", "[,1]", "[1 2]", "[1,2", "[1,2]x", "[\"a,]\", [\"]\"], {\"b\": \"[\"}]",
+        "[[[]]", "[{]}]", "[1,nul]", "{\"a\": [1, 2]}", "\"a\"", "[1,2]]"
+    };
+    static char buf[1 << 18];
+    size_t i, j, n, threads, len;
+    char *q;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (threads = 0; threads <= 4; threads++) {
+            test_parse_parallel_equal(cases[i], strlen(cases[i]), threads);
+        }
+    }
+
+    /* arrays of many pieces, whole and with one byte broken */
+    test_seed = 47;
+    for (i = 0; i < 40; i++) {
+        q = buf;
+        *q++ = '[';
+        for (j = 0, n = 100 + test_rand(3000); (size_t)(q - buf) < sizeof(buf) / 2 && j < n; j++) {
+            if (j != 0) {
+                *q++ = ',';
+            }
+            q = test_gen_space(q);
+            q = test_gen_value(q, 0);
+            q = test_gen_space(q);
+        }
+        *q++ = ']';
+        len = (size_t)(q - buf);
+        threads = 2 + test_rand(4);
+        test_parse_parallel_equal(buf, len, threads);
+        buf[test_rand((unsigned)len)] = "[]{}\",:x\0"[test_rand(9)];
+        test_parse_parallel_equal(buf, len, threads);
+    }
+}
+
 static void test_parse() {
     test_parse_null();
     test_parse_true();
     test_parse_false();
     test_parse_number();
+    test_parse_integer();
+    test_parse_lazy_number();
     test_parse_string();
     test_parse_array();
     test_parse_object();
+    test_parse_insitu();
+    test_parse_document();
+    test_parse_allocator();
+    test_parse_parser();
 
     test_parse_expect_value();
     test_parse_invalid_value();
+    test_parse_literal_word();
     test_parse_root_not_singular();
     test_parse_number_too_big();
 
@@ -434,7 +2373,25 @@ static void test_parse() {
     test_parse_miss_key();
     test_parse_miss_colon();
     test_parse_miss_comma_or_curly_bracket();
+    test_parse_too_deep();
 
+    test_parse_whitespace_simd();
+    test_parse_string_simd();
+    test_parse_utf8();
+    test_parse_escape_heavy();
+    test_parse_indexed();
+    test_parse_tape();
+    test_parse_ondemand();
+    test_parse_locale();
+    test_parse_sax();
+    test_parse_reader();
+    test_parse_stream();
+    test_parse_ndjson();
+    test_parse_parallel();
+    test_parse_n();
+    test_parse_keys();
+    test_parse_project();
+    test_parse_file();
 }
 
 static void test_stringify_object() {
@@ -466,6 +2423,9 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("1.5");
     TEST_ROUNDTRIP("-1.5");
     TEST_ROUNDTRIP("3.25");
+    TEST_ROUNDTRIP("1234567890123456789");
+    TEST_ROUNDTRIP("-9223372036854775808");
+    TEST_ROUNDTRIP("18446744073709551615");
 #if 0
     TEST_ROUNDTRIP("1.23e20");
     TEST_ROUNDTRIP("1.23e+20");
@@ -489,6 +2449,7 @@ static void test_access() {
     test_access_null();
     test_access_boolean();
     test_access_number();
+    test_access_integer();
     test_access_string();
 }
 int main() {